@@ -0,0 +1,163 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+// Учёт выделений памяти через замену глобальных operator new/delete.
+// Включается флагом -DALLOC_TRACKING (цель bench в Makefile); заголовок
+// с этим флагом подключается ровно в одной единице трансляции — main.cpp
+struct AllocStats {
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t bytesAllocated = 0;
+    uint64_t liveBytes = 0;
+    uint64_t peakBytes = 0;
+};
+
+namespace alloctrack {
+
+inline atomic<uint64_t> allocations{0};
+inline atomic<uint64_t> frees{0};
+inline atomic<uint64_t> bytesAllocated{0};
+inline atomic<uint64_t> liveBytes{0};
+inline atomic<uint64_t> peakBytes{0};
+
+inline bool enabled() {
+#ifdef ALLOC_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+inline AllocStats snapshot() {
+    AllocStats s;
+    s.allocations = allocations.load(memory_order_relaxed);
+    s.frees = frees.load(memory_order_relaxed);
+    s.bytesAllocated = bytesAllocated.load(memory_order_relaxed);
+    s.liveBytes = liveBytes.load(memory_order_relaxed);
+    s.peakBytes = peakBytes.load(memory_order_relaxed);
+    return s;
+}
+
+// Пик считается заново от текущего объёма живой памяти
+inline void resetPeak() {
+    peakBytes.store(liveBytes.load(memory_order_relaxed), memory_order_relaxed);
+}
+
+inline void onAlloc(size_t size) {
+    allocations.fetch_add(1, memory_order_relaxed);
+    bytesAllocated.fetch_add(size, memory_order_relaxed);
+    uint64_t live = liveBytes.fetch_add(size, memory_order_relaxed) + size;
+    uint64_t peak = peakBytes.load(memory_order_relaxed);
+    while (live > peak && !peakBytes.compare_exchange_weak(peak, live, memory_order_relaxed)) {}
+}
+
+inline void onFree(size_t size) {
+    frees.fetch_add(1, memory_order_relaxed);
+    liveBytes.fetch_sub(size, memory_order_relaxed);
+}
+
+// Размер блока хранится перед ним; 16 байт сохраняют выравнивание max_align_t
+constexpr size_t HEADER = 16;
+
+inline void* allocate(size_t size) {
+    void* raw = malloc(size + HEADER);
+    if (!raw) return nullptr;
+    *static_cast<size_t*>(raw) = size;
+    onAlloc(size);
+    return static_cast<char*>(raw) + HEADER;
+}
+
+// Освобождение не встраивается в operator delete: иначе GCC видит free
+// указателя из new со сдвигом назад и выдаёт ложные -Wmismatched-new-delete
+// и -Warray-bounds
+__attribute__((noinline)) inline void deallocate(void* p) {
+    if (!p) return;
+    void* raw = static_cast<char*>(p) - HEADER;
+    onFree(*static_cast<size_t*>(raw));
+    free(raw);
+}
+
+// Выровненный блок: заголовок занимает align байт, в последних 16 из них
+// лежат размер и начало блока для free
+inline void* allocateAligned(size_t size, size_t align) {
+    if (align < HEADER) align = HEADER;
+    size_t total = (size + 2 * align - 1) / align * align;
+    void* raw = aligned_alloc(align, total);
+    if (!raw) return nullptr;
+    char* p = static_cast<char*>(raw) + align;
+    *reinterpret_cast<size_t*>(p - HEADER) = size;
+    *reinterpret_cast<void**>(p - HEADER / 2) = raw;
+    onAlloc(size);
+    return p;
+}
+
+__attribute__((noinline)) inline void deallocateAligned(void* p) {
+    if (!p) return;
+    char* c = static_cast<char*>(p);
+    onFree(*reinterpret_cast<size_t*>(c - HEADER));
+    free(*reinterpret_cast<void**>(c - HEADER / 2));
+}
+
+}  // namespace alloctrack
+
+#ifdef ALLOC_TRACKING
+
+void* operator new(size_t size) {
+    void* p = alloctrack::allocate(size);
+    if (!p) throw bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    void* p = alloctrack::allocate(size);
+    if (!p) throw bad_alloc();
+    return p;
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept {
+    return alloctrack::allocate(size);
+}
+
+void* operator new[](size_t size, const nothrow_t&) noexcept {
+    return alloctrack::allocate(size);
+}
+
+void* operator new(size_t size, align_val_t align) {
+    void* p = alloctrack::allocateAligned(size, static_cast<size_t>(align));
+    if (!p) throw bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size, align_val_t align) {
+    void* p = alloctrack::allocateAligned(size, static_cast<size_t>(align));
+    if (!p) throw bad_alloc();
+    return p;
+}
+
+void* operator new(size_t size, align_val_t align, const nothrow_t&) noexcept {
+    return alloctrack::allocateAligned(size, static_cast<size_t>(align));
+}
+
+void* operator new[](size_t size, align_val_t align, const nothrow_t&) noexcept {
+    return alloctrack::allocateAligned(size, static_cast<size_t>(align));
+}
+
+void operator delete(void* p) noexcept { alloctrack::deallocate(p); }
+void operator delete[](void* p) noexcept { alloctrack::deallocate(p); }
+void operator delete(void* p, size_t) noexcept { alloctrack::deallocate(p); }
+void operator delete[](void* p, size_t) noexcept { alloctrack::deallocate(p); }
+void operator delete(void* p, const nothrow_t&) noexcept { alloctrack::deallocate(p); }
+void operator delete[](void* p, const nothrow_t&) noexcept { alloctrack::deallocate(p); }
+void operator delete(void* p, align_val_t) noexcept { alloctrack::deallocateAligned(p); }
+void operator delete[](void* p, align_val_t) noexcept { alloctrack::deallocateAligned(p); }
+void operator delete(void* p, size_t, align_val_t) noexcept { alloctrack::deallocateAligned(p); }
+void operator delete[](void* p, size_t, align_val_t) noexcept { alloctrack::deallocateAligned(p); }
+void operator delete(void* p, align_val_t, const nothrow_t&) noexcept { alloctrack::deallocateAligned(p); }
+void operator delete[](void* p, align_val_t, const nothrow_t&) noexcept { alloctrack::deallocateAligned(p); }
+
+#endif
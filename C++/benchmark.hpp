@@ -2,51 +2,260 @@
 #include <vector>
 #include <string>
 #include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include <memory>
+
+#include "histogram.hpp"
+#include "perfcounters.hpp"
+#include "alloctrack.hpp"
+#include "workload.hpp"
+#include "Queue.hpp"
+#include "Stack.hpp"
 
 using namespace std;
 
+// Параметры замера: прогревочные запуски не учитываются в статистике
+struct BenchConfig {
+    int warmup = 1;
+    int repeats = 5;
+    bool latency = false;  // замерять каждую операцию серии отдельно
+    bool perf = false;     // аппаратные счётчики на каждый замер
+};
+
+// Выделения памяти за замеры (только в сборке с -DALLOC_TRACKING)
+struct AllocTotals {
+    bool enabled = false;
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t peakBytes = 0;  // наибольший прирост живой памяти за один замер
+    size_t runs = 0;
+
+    double allocationsPerOp(size_t opsPerRun) const {
+        return runs && opsPerRun ? static_cast<double>(allocations) / runs / opsPerRun : 0;
+    }
+
+    double freesPerOp(size_t opsPerRun) const {
+        return runs && opsPerRun ? static_cast<double>(frees) / runs / opsPerRun : 0;
+    }
+};
+
+// Статистика по замерам, все времена в наносекундах
+struct BenchStats {
+    size_t runs = 0;
+    long long min = 0;
+    long long median = 0;
+    long long p90 = 0;
+    long long p99 = 0;
+    long long max = 0;
+    double mean = 0;
+    double stddev = 0;
+    PerfTotals perf;
+    AllocTotals alloc;
+};
+
+struct BenchResult {
+    BenchStats once;    // одна операция
+    BenchStats series;  // серия из n операций
+    bool hasOnce = false;
+    BenchStats perKey;  // findbatch: поштучный contains по тем же ключам
+    bool hasPerKey = false;
+    LatencyHistogram latency;  // задержки отдельных операций серии
+    long long footprintBytes = -1;  // память структуры после вставки всех ключей
+};
+
+// Не даёт компилятору выбросить результат замеряемой операции
+template<typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
 template<typename Func>
 long long benchmark(Func f) {
-    auto start = std::chrono::high_resolution_clock::now();
+    auto start = std::chrono::steady_clock::now();
     f();
-    auto end = std::chrono::high_resolution_clock::now();
-    return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+inline long long percentile(const vector<long long>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t rank = static_cast<size_t>(ceil(p / 100.0 * sorted.size()));
+    if (rank == 0) rank = 1;
+    return sorted[min(rank, sorted.size()) - 1];
+}
+
+inline BenchStats computeStats(vector<long long> samples) {
+    BenchStats s;
+    s.runs = samples.size();
+    if (samples.empty()) return s;
+
+    sort(samples.begin(), samples.end());
+    s.min = samples.front();
+    s.max = samples.back();
+    s.median = percentile(samples, 50);
+    s.p90 = percentile(samples, 90);
+    s.p99 = percentile(samples, 99);
+
+    double sum = 0;
+    for (auto x : samples) sum += x;
+    s.mean = sum / samples.size();
+
+    double sq = 0;
+    for (auto x : samples) sq += (x - s.mean) * (x - s.mean);
+    s.stddev = samples.size() > 1 ? sqrt(sq / (samples.size() - 1)) : 0;
+    return s;
+}
+
+// setup() готовит состояние вне замера, run() замеряется
+template<typename Setup, typename Func>
+BenchStats measure(const BenchConfig& cfg, Setup setup, Func run) {
+    for (int i = 0; i < cfg.warmup; ++i) {
+        setup();
+        run();
+    }
+
+    unique_ptr<PerfCounters> counters;
+    if (cfg.perf) counters = make_unique<PerfCounters>();
+    PerfTotals perf;
+
+    vector<long long> samples;
+    samples.reserve(cfg.repeats);
+    AllocTotals alloc;
+    alloc.enabled = alloctrack::enabled();
+
+    for (int i = 0; i < cfg.repeats; ++i) {
+        setup();
+        AllocStats before = alloctrack::snapshot();
+        alloctrack::resetPeak();
+        if (counters) counters->start();
+        samples.push_back(benchmark(run));
+        if (counters) {
+            counters->stop();
+            perf.add(*counters);
+        }
+        AllocStats after = alloctrack::snapshot();
+        alloc.allocations += after.allocations - before.allocations;
+        alloc.frees += after.frees - before.frees;
+        alloc.peakBytes = max(alloc.peakBytes, after.peakBytes - before.liveBytes);
+        alloc.runs++;
+    }
+
+    BenchStats stats = computeStats(samples);
+    stats.perf = perf;
+    stats.alloc = alloc;
+    return stats;
+}
+
+// Серия op(x) по всем data. При cfg.latency дополнительно прогоняет серию
+// с замером каждой операции: время вызова часов не попадает в общий итог
+template<typename Setup, typename Op>
+BenchStats measureSeries(const BenchConfig& cfg, const vector<int>& data,
+                         Setup setup, Op op, BenchResult& result) {
+    BenchStats stats = measure(cfg, setup, [&]() {
+        for (auto x : data) op(x);
+    });
+
+    if (cfg.latency) {
+        for (int i = 0; i < cfg.repeats; ++i) {
+            setup();
+            for (auto x : data) {
+                auto start = std::chrono::steady_clock::now();
+                op(x);
+                auto end = std::chrono::steady_clock::now();
+                result.latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            }
+        }
+    }
+    return stats;
+}
+
+// Серия вставок всех data, на каждом повторе — в новую структуру из make():
+// clear() у хэш-таблиц сохраняет выросшую ёмкость, и после прогрева ни
+// одна вставка не попала бы на rehash. Старая структура удаляется вне замера
+template<typename Make, typename Insert>
+BenchStats measureInserts(const BenchConfig& cfg, const vector<int>& data,
+                          Make make, Insert insert, BenchResult& result) {
+    decltype(make()) ds;
+    auto fresh = [&]() {
+        ds.reset();
+        ds = make();
+    };
+    return measureSeries(cfg, data, fresh, [&](int x) { insert(*ds, x); }, result);
+}
+
+// Размер пакета запросов в findbatch
+constexpr size_t FIND_BATCH = 256;
+
+template<typename DS, typename = void>
+struct hasContainsBatch : false_type {};
+
+template<typename DS>
+struct hasContainsBatch<DS, void_t<decltype(declval<const DS&>().contains_batch(
+    static_cast<const int*>(nullptr), size_t{0}, static_cast<bool*>(nullptr)))>> : true_type {};
+
+// Поиск всех ключей data пакетами по FIND_BATCH через contains_batch;
+// для сравнения тот же порядок запросов прогоняется поштучным contains
+template<typename DS>
+void runFindBatch(const string& operation, DS& ds, const vector<int>& data,
+                  const BenchConfig& cfg, BenchResult& result) {
+    if constexpr (hasContainsBatch<DS>::value) {
+        auto noop = []() {};
+        bool out[FIND_BATCH];
+
+        result.series = measure(cfg, noop, [&]() {
+            for (size_t base = 0; base < data.size(); base += FIND_BATCH) {
+                ds.contains_batch(data.data() + base, min(FIND_BATCH, data.size() - base), out);
+                doNotOptimize(out[0]);
+            }
+        });
+        result.perKey = measure(cfg, noop, [&]() {
+            for (auto x : data) doNotOptimize(ds.contains(x));
+        });
+        result.hasPerKey = true;
+    } else {
+        throw runtime_error("Операция " + operation + " не поддерживается этой структурой");
+    }
 }
 
 template <typename DS>
 int runDSBenchmark(const string& operation, vector<int>& data, int n,
-                 long long& timeOnce, long long& timeSeries)
+                 const BenchConfig& cfg, BenchResult& result)
 {
     DS ds;
-
-    if (operation == "find" || operation == "remove") {
+    auto fill = [&]() {
+        ds.clear();
         for (auto x : data) ds.push_back(x);
-    }
+    };
+    auto noop = []() {};
 
     if (operation == "insert") {
-        timeSeries = benchmark([&]() {
-            for (auto x : data) ds.push_back(x);
-        });
+        result.series = measureInserts(cfg, data, []() { return make_unique<DS>(); },
+                                       [](DS& fresh, int x) { fresh.push_back(x); }, result);
     }
     else if (operation == "find") {
+        fill();
         int target = ds.at(n / 2);
 
-        timeOnce = benchmark([&]() { ds.find(target); });
+        result.once = measure(cfg, noop, [&]() { doNotOptimize(ds.find(target)); });
+        result.hasOnce = true;
 
-        timeSeries = benchmark([&]() {
-            for (auto x : data) ds.find(x);
-        });
+        result.series = measureSeries(cfg, data, noop,
+                                      [&](int x) { doNotOptimize(ds.find(x)); }, result);
     }
     else if (operation == "remove") {
+        fill();
         int target = ds.at(n / 2);
 
-        timeOnce = benchmark([&]() { ds.remove(target); });
+        result.once = measure(cfg, fill, [&]() { ds.remove(target); });
+        result.hasOnce = true;
 
         data.erase(remove(data.begin(), data.end(), target), data.end());
 
-        timeSeries = benchmark([&]() {
-            for (auto x : data) ds.remove(x);
-        });
+        result.series = measureSeries(cfg, data, fill,
+                                      [&](int x) { ds.remove(x); }, result);
     }
     else {
         throw runtime_error("Неизвестная операция: " + operation);
@@ -55,35 +264,233 @@ int runDSBenchmark(const string& operation, vector<int>& data, int n,
     return 0;
 }
 
+// Для множеств (push_back/contains/remove); make() возвращает unique_ptr
+// на новую структуру — так вызывающий задаёт ёмкость заранее
+template <typename Make>
+int runSetBenchmark(const string& operation, const vector<int>& data, int n,
+                 Make make, const BenchConfig& cfg, BenchResult& result)
+{
+    using DS = typename decltype(make())::element_type;
+    auto owned = make();
+    DS& ds = *owned;
+    auto fill = [&]() {
+        ds.clear();
+        for (auto x : data) ds.push_back(x);
+    };
+    auto noop = []() {};
+
+    if (operation == "insert") {
+        result.series = measureInserts(cfg, data, make,
+                                       [](DS& fresh, int x) { fresh.push_back(x); }, result);
+    }
+    else if (operation == "find") {
+        fill();
+        int target = data[n / 2];
+
+        result.once = measure(cfg, noop, [&]() { doNotOptimize(ds.contains(target)); });
+        result.hasOnce = true;
+
+        result.series = measureSeries(cfg, data, noop,
+                                      [&](int x) { doNotOptimize(ds.contains(x)); }, result);
+    }
+    else if (operation == "findbatch") {
+        fill();
+        runFindBatch(operation, ds, data, cfg, result);
+    }
+    else if (operation == "remove") {
+        int target = data[n / 2];
+
+        result.once = measure(cfg, fill, [&]() { ds.remove(target); });
+        result.hasOnce = true;
+
+        result.series = measureSeries(cfg, data, fill,
+                                      [&](int x) { ds.remove(x); }, result);
+    }
+    else {
+        throw runtime_error("Неизвестная операция: " + operation);
+        return 1;
+    }
+
+    return 0;
+}
+
 template <typename DS>
 int runHashBenchmark(const string& operation, const vector<int>& data, int n,
-                 long long& timeOnce, long long& timeSeries)
+                 const BenchConfig& cfg, BenchResult& result)
 {
-    DS ds;
+    return runSetBenchmark(operation, data, n, []() { return make_unique<DS>(); }, cfg, result);
+}
 
-    if (operation == "find" || operation == "remove") {
-        for (auto x : data) ds.push_back(x);
-    }
+// Для словарей (put/contains/remove), значение = ключ + 1; make() — как
+// в runSetBenchmark
+template <typename Make>
+int runMapBenchmark(const string& operation, const vector<int>& data, int n,
+                 Make make, const BenchConfig& cfg, BenchResult& result)
+{
+    using Map = typename decltype(make())::element_type;
+    auto owned = make();
+    Map& map = *owned;
+    auto fill = [&]() {
+        map.clear();
+        for (auto x : data) map.put(x, x + 1);
+    };
+    auto noop = []() {};
 
     if (operation == "insert") {
-        timeSeries = benchmark([&]() {
-            for (auto x : data) ds.push_back(x);
-        });
+        result.series = measureInserts(cfg, data, make,
+                                       [](Map& fresh, int x) { fresh.put(x, x + 1); }, result);
     }
     else if (operation == "find") {
-        timeSeries = benchmark([&]() {
-            for (auto x : data) ds.contains(x);
-        });
+        fill();
+        int target = data[n / 2];
+
+        result.once = measure(cfg, noop, [&]() { doNotOptimize(map.contains(target)); });
+        result.hasOnce = true;
+
+        result.series = measureSeries(cfg, data, noop,
+                                      [&](int x) { doNotOptimize(map.contains(x)); }, result);
+    }
+    else if (operation == "findbatch") {
+        fill();
+        runFindBatch(operation, map, data, cfg, result);
     }
     else if (operation == "remove") {
-        timeSeries = benchmark([&]() {
-            for (auto x : data) ds.remove(x);
-        });
+        int target = data[n / 2];
+
+        result.once = measure(cfg, fill, [&]() { map.remove(target); });
+        result.hasOnce = true;
+
+        result.series = measureSeries(cfg, data, fill,
+                                      [&](int x) { map.remove(x); }, result);
     }
     else {
         throw runtime_error("Неизвестная операция: " + operation);
-        return 1;
     }
 
     return 0;
-}
\ No newline at end of file
+}
+
+// Единый интерфейс для смешанной нагрузки: словари вставляют через put,
+// остальные структуры — через push_back
+template<typename DS, typename = void>
+struct isMapLike : false_type {};
+
+template<typename DS>
+struct isMapLike<DS, void_t<decltype(declval<DS&>().put(0, 0))>> : true_type {};
+
+template<typename DS>
+void benchInsert(DS& ds, int x) {
+    if constexpr (isMapLike<DS>::value) ds.put(x, x + 1);
+    else ds.push_back(x);
+}
+
+template<typename DS>
+bool benchContains(DS& ds, int x) {
+    return ds.contains(x);
+}
+
+template<typename DS>
+void benchRemove(DS& ds, int x) {
+    // Queue и Stack удаляют крайний элемент и бросают исключение, если пусто
+    if constexpr (is_same_v<DS, Queue<int>> || is_same_v<DS, Stack<int>>) {
+        if (ds.empty()) return;
+    }
+    ds.remove(x);
+}
+
+template<typename DS>
+void runMixedOp(DS& ds, const MixedOp& op) {
+    switch (op.type) {
+        case MixedOp::READ: doNotOptimize(benchContains(ds, op.key)); break;
+        case MixedOp::INSERT: benchInsert(ds, op.key); break;
+        case MixedOp::REMOVE: benchRemove(ds, op.key); break;
+    }
+}
+
+// Смешанная нагрузка: перед каждым замером структура заново заполняется
+// preload, затем выполняется поток ops. При cfg.latency задержки отдельных
+// операций собираются отдельным проходом, чтобы не искажать общее время
+template <typename DS>
+int runMixedBenchmark(DS& ds, const vector<int>& preload, const vector<MixedOp>& ops,
+                      const BenchConfig& cfg, BenchResult& result)
+{
+    auto fill = [&]() {
+        ds.clear();
+        for (auto x : preload) benchInsert(ds, x);
+    };
+
+    result.series = measure(cfg, fill, [&]() {
+        for (const auto& op : ops) runMixedOp(ds, op);
+    });
+
+    for (int i = 0; cfg.latency && i < cfg.repeats; ++i) {
+        fill();
+        for (const auto& op : ops) {
+            auto start = std::chrono::steady_clock::now();
+            runMixedOp(ds, op);
+            auto end = std::chrono::steady_clock::now();
+            result.latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        }
+    }
+
+    return 0;
+}
+
+// Точка кривой устойчивого обновления: время contains после cycles циклов
+// "вставить новый ключ, удалить самый старый" при постоянном размере n
+struct ChurnPoint {
+    long long cycles = 0;
+    BenchStats hit;   // серия contains по n присутствующим ключам
+    BenchStats miss;  // серия contains по n отсутствующим ключам
+};
+
+// i-й ключ потока: умножение на нечётное число — биекция на [0, 2^31),
+// поэтому ключи различны, но не идут подряд
+inline int churnKey(long long i) {
+    return static_cast<int>((static_cast<uint32_t>(i) * 2654435761u) & 0x7fffffffu);
+}
+
+// Окно из n ключей сдвигается на один ключ за цикл. После каждой из points
+// равных частей cycles замеряет contains: если удаления оставляют следы
+// (DELETED, длинные цепочки), время промахов растёт с числом циклов
+template <typename DS>
+vector<ChurnPoint> runChurnBenchmark(DS& ds, int n, long long cycles, int points, const BenchConfig& cfg) {
+    // ключи промахов берутся из второй половины диапазона, окно до неё не доходит
+    const long long missBase = 1LL << 30;
+    if (n < 1 || points < 1 || cycles < 0 || cycles + n > missBase) {
+        throw invalid_argument("Некорректные параметры churn");
+    }
+
+    ds.clear();
+    for (long long i = 0; i < n; ++i) benchInsert(ds, churnKey(i));
+
+    vector<int> misses(n);
+    for (int i = 0; i < n; ++i) misses[i] = churnKey(missBase + i);
+
+    auto noop = []() {};
+    vector<int> hits(n);
+    vector<ChurnPoint> result;
+    long long done = 0;
+
+    for (int p = 0; p <= points; ++p) {
+        long long target = cycles * p / points;
+        for (; done < target; ++done) {
+            benchInsert(ds, churnKey(done + n));
+            benchRemove(ds, churnKey(done));
+        }
+
+        for (int i = 0; i < n; ++i) hits[i] = churnKey(done + i);
+
+        ChurnPoint point;
+        point.cycles = done;
+        point.hit = measure(cfg, noop, [&]() {
+            for (int x : hits) doNotOptimize(benchContains(ds, x));
+        });
+        point.miss = measure(cfg, noop, [&]() {
+            for (int x : misses) doNotOptimize(benchContains(ds, x));
+        });
+        result.push_back(point);
+    }
+
+    return result;
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+using namespace std;
+
+// Гистограмма задержек с логарифмическими корзинами (как в HdrHistogram):
+// каждая степень двойки делится на SUB_COUNT равных частей,
+// поэтому относительная погрешность не больше 1 / SUB_COUNT (~3%)
+class LatencyHistogram {
+private:
+    static constexpr int SUB_BITS = 5;
+    static constexpr uint64_t SUB_COUNT = 1ull << SUB_BITS;
+    static constexpr size_t BUCKETS = 64 - SUB_BITS + 1;
+
+    vector<uint64_t> counts;
+    uint64_t total = 0;
+    uint64_t minValue = UINT64_MAX;
+    uint64_t maxValue = 0;
+    long double sum = 0;
+
+    static size_t indexOf(uint64_t v) {
+        if (v < SUB_COUNT) return static_cast<size_t>(v);
+        int msb = 63 - __builtin_clzll(v);
+        int shift = msb - SUB_BITS;
+        size_t bucket = static_cast<size_t>(shift) + 1;
+        size_t sub = static_cast<size_t>((v >> shift) - SUB_COUNT);
+        return bucket * SUB_COUNT + sub;
+    }
+
+    // Наибольшее значение, попадающее в корзину idx
+    static uint64_t highestOf(size_t idx) {
+        size_t bucket = idx / SUB_COUNT;
+        uint64_t sub = idx % SUB_COUNT;
+        if (bucket == 0) return sub;
+        int shift = static_cast<int>(bucket) - 1;
+        uint64_t low = (SUB_COUNT + sub) << shift;
+        return low + ((1ull << shift) - 1);
+    }
+
+public:
+    LatencyHistogram() : counts(BUCKETS * SUB_COUNT, 0) {}
+
+    void record(uint64_t value) {
+        counts[indexOf(value)]++;
+        total++;
+        sum += value;
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < counts.size(); ++i) counts[i] += other.counts[i];
+        total += other.total;
+        sum += other.sum;
+        minValue = std::min(minValue, other.minValue);
+        maxValue = std::max(maxValue, other.maxValue);
+    }
+
+    void clear() {
+        fill(counts.begin(), counts.end(), 0);
+        total = 0;
+        sum = 0;
+        minValue = UINT64_MAX;
+        maxValue = 0;
+    }
+
+    uint64_t count() const { return total; }
+    uint64_t min() const { return total ? minValue : 0; }
+    uint64_t max() const { return maxValue; }
+    double mean() const { return total ? static_cast<double>(sum / total) : 0; }
+
+    // p в процентах, например 99.9
+    uint64_t percentile(double p) const {
+        if (total == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(p / 100.0 * total + 0.5);
+        if (rank == 0) rank = 1;
+        if (rank > total) rank = total;
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            seen += counts[i];
+            if (seen >= rank) return std::min(highestOf(i), maxValue);
+        }
+        return maxValue;
+    }
+};
@@ -0,0 +1,331 @@
+#pragma once
+#include <cstdint>
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <vector>
+#include <utility>
+
+#include "HashFunctions.hpp"
+#include "NodePool.hpp"
+#include "../../json.hpp"
+
+using namespace std;
+
+// Хэш-таблица с цепочками для общего доступа из нескольких потоков.
+// Корзины разбиты на STRIPES полос по старшим битам хэша: при любой
+// ёмкости полоса — непрерывный диапазон корзин со своим shared_mutex.
+// get/contains берут его на чтение, put/remove — на запись, поэтому
+// операции с разными полосами друг друга не ждут.
+// Рост: новая таблица выделяется без блокировок полос, затем полосы
+// переносятся по одной под своей блокировкой. Читатель ждёт только перенос
+// своей полосы (capacity / STRIPES корзин), а не всю перестройку
+template<typename Key, typename Value, typename Hash = FastHash<Key>, typename KeyEqual = equal_to<Key>>
+class ConcurrentSeparateChainingHashMap {
+private:
+    struct Node {
+        Key key;
+        Value value;
+        size_t hash;  // при переносе ключ не хэшируется заново
+        Node* next;
+        Node(const Key& k, const Value& v, size_t h, Node* n) : key(k), value(v), hash(h), next(n) {}
+    };
+
+    static constexpr unsigned STRIPE_BITS = 6;
+    static constexpr size_t STRIPES = size_t{1} << STRIPE_BITS;
+    static constexpr double LOAD_FACTOR = 1.0;
+
+    // Все поля полосы защищены её lock. Ключ при росте остаётся в той же
+    // полосе, поэтому и узлы выделяются из пула полосы
+    struct alignas(64) Stripe {
+        mutable shared_mutex lock;
+        Node** buckets = nullptr;  // начало диапазона полосы в текущей таблице
+        unsigned bits = 0;         // log2 числа корзин полосы
+        size_t count = 0;
+        NodePool<Node> pool;
+
+        size_t bucketOf(size_t h) const {
+            return hashing::fibonacciIndex(h, STRIPE_BITS + bits) & ((size_t{1} << bits) - 1);
+        }
+
+        Node* find(const Key& key, size_t h) const {
+            for (Node* node = buckets[bucketOf(h)]; node; node = node->next) {
+                if (node->hash == h && KeyEqual{}(node->key, key)) return node;
+            }
+            return nullptr;
+        }
+
+        // Узлы не копируются и не перевыделяются, только перецепляются
+        void moveTo(Node** dest, unsigned newBits) {
+            size_t len = size_t{1} << bits;
+            Node** from = buckets;
+            buckets = dest;
+            bits = newBits;
+            for (size_t i = 0; i < len; i++) {
+                Node* node = from[i];
+                while (node) {
+                    Node* next = node->next;
+                    Node*& head = buckets[bucketOf(node->hash)];
+                    node->next = head;
+                    head = node;
+                    node = next;
+                }
+            }
+        }
+
+        void destroyNodes() {
+            for (size_t i = 0; i < (size_t{1} << bits); i++) {
+                Node* node = buckets[i];
+                while (node) {
+                    Node* next = node->next;
+                    pool.destroy(node);
+                    node = next;
+                }
+                buckets[i] = nullptr;
+            }
+            count = 0;
+        }
+    };
+
+    Stripe stripes[STRIPES];
+    mutex resizeLock;           // один рост за раз; защищает table и bits_
+    unique_ptr<Node*[]> table;  // 2^bits_ корзин, полоса s начинается с s << (bits_ - STRIPE_BITS)
+    unsigned bits_;
+
+    static size_t stripeOf(size_t h) { return hashing::fibonacciIndex(h, STRIPE_BITS); }
+    void grow(unsigned seenBits);
+
+    template<typename F>
+    void forEachEntry(F f) const {
+        for (const Stripe& s : stripes) {
+            shared_lock<shared_mutex> guard(s.lock);
+            for (size_t i = 0; i < (size_t{1} << s.bits); i++) {
+                for (Node* node = s.buckets[i]; node; node = node->next) f(node->key, node->value);
+            }
+        }
+    }
+
+public:
+    // Признак для бенчмарка потоков: внешний мьютекс не нужен
+    static constexpr bool concurrent = true;
+
+    ConcurrentSeparateChainingHashMap(size_t initialCapacity = 64);
+    ConcurrentSeparateChainingHashMap(const ConcurrentSeparateChainingHashMap&) = delete;
+    ConcurrentSeparateChainingHashMap& operator=(const ConcurrentSeparateChainingHashMap&) = delete;
+    ~ConcurrentSeparateChainingHashMap();
+
+    void put(const Key& key, const Value& value);
+    bool remove(const Key& key);
+    bool contains(const Key& key) const;
+    // Значение возвращается копией: ссылка пережила бы блокировку полосы
+    Value get(const Key& key) const;
+    bool tryGet(const Key& key, Value& out) const;
+
+    // size, items и сериализация обходят полосы по очереди: при
+    // параллельных изменениях это не снимок таблицы на один момент
+    size_t size() const;
+    bool empty() const;
+    size_t bucketCount() const;
+    vector<pair<Key, Value>> items() const;
+    void display() const;
+    void clear();
+
+    void to_json(nlohmann::json& j) const {
+        j = nlohmann::json{{"items", nlohmann::json::array()}, {"capacity", bucketCount()}};
+        forEachEntry([&](const Key& key, const Value& value) {
+            j["items"].push_back({{"key", key}, {"value", value}});
+        });
+    }
+
+    void from_json(const nlohmann::json& j) {
+        clear();
+        auto arr = j.at("items");
+        for (size_t i = 0; i < arr.size(); ++i) {
+            put(arr[i]["key"].get<Key>(), arr[i]["value"].get<Value>());
+        }
+    }
+
+    void to_binary(ostream& out) const {
+        // capacity, число пар, затем key, value
+        vector<pair<Key, Value>> all = items();
+        size_t capacity = bucketCount(), count = all.size();
+        out.write(reinterpret_cast<const char*>(&capacity), sizeof(capacity));
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        for (const auto& [key, value] : all) {
+            out.write(reinterpret_cast<const char*>(&key), sizeof(Key));
+            out.write(reinterpret_cast<const char*>(&value), sizeof(Value));
+        }
+    }
+
+    void from_binary(istream& in) {
+        clear();
+        size_t capacity = 0, count = 0;
+        in.read(reinterpret_cast<char*>(&capacity), sizeof(capacity));
+        in.read(reinterpret_cast<char*>(&count), sizeof(count));
+        for (size_t i = 0; i < count; ++i) {
+            Key key;
+            Value value;
+            in.read(reinterpret_cast<char*>(&key), sizeof(Key));
+            in.read(reinterpret_cast<char*>(&value), sizeof(Value));
+            if (!in) break;
+            put(key, value);
+        }
+    }
+};
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+ConcurrentSeparateChainingHashMap<Key, Value, Hash, KeyEqual>::ConcurrentSeparateChainingHashMap(size_t initialCapacity)
+    : bits_(max(STRIPE_BITS, hashing::log2Pow2(hashing::roundUpPow2(initialCapacity)))) {
+    table.reset(new Node*[size_t{1} << bits_]());
+    unsigned stripeBits = bits_ - STRIPE_BITS;
+    for (size_t s = 0; s < STRIPES; s++) {
+        stripes[s].buckets = table.get() + (s << stripeBits);
+        stripes[s].bits = stripeBits;
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+ConcurrentSeparateChainingHashMap<Key, Value, Hash, KeyEqual>::~ConcurrentSeparateChainingHashMap() {
+    for (Stripe& s : stripes) s.destroyNodes();
+}
+
+// seenBits — log2 ёмкости, при которой полоса оказалась переполнена.
+// Если рост уже идёт или ёмкость успела измениться, ничего не делаем:
+// полоса снова запросит рост при следующей вставке
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void ConcurrentSeparateChainingHashMap<Key, Value, Hash, KeyEqual>::grow(unsigned seenBits) {
+    unique_lock<mutex> guard(resizeLock, try_to_lock);
+    if (!guard.owns_lock() || bits_ != seenBits) return;
+
+    unsigned newBits = bits_ + 1;
+    unique_ptr<Node*[]> next(new Node*[size_t{1} << newBits]());
+    unsigned stripeBits = newBits - STRIPE_BITS;
+
+    for (size_t s = 0; s < STRIPES; s++) {
+        unique_lock<shared_mutex> lock(stripes[s].lock);
+        stripes[s].moveTo(next.get() + (s << stripeBits), stripeBits);
+    }
+
+    // все полосы указывают в новую таблицу, к старой никто не обращается
+    table = move(next);
+    bits_ = newBits;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void ConcurrentSeparateChainingHashMap<Key, Value, Hash, KeyEqual>::put(const Key& key, const Value& value) {
+    size_t h = Hash{}(key);
+    Stripe& s = stripes[stripeOf(h)];
+    unsigned seenBits = 0;
+    {
+        unique_lock<shared_mutex> lock(s.lock);
+        if (Node* node = s.find(key, h)) {
+            node->value = value;
+            return;
+        }
+        Node*& head = s.buckets[s.bucketOf(h)];
+        head = s.pool.create(key, value, h, head);
+        s.count++;
+        if (s.count > LOAD_FACTOR * (size_t{1} << s.bits)) seenBits = s.bits + STRIPE_BITS;
+    }
+    // рост берёт блокировки полос сам
+    if (seenBits) grow(seenBits);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool ConcurrentSeparateChainingHashMap<Key, Value, Hash, KeyEqual>::remove(const Key& key) {
+    size_t h = Hash{}(key);
+    Stripe& s = stripes[stripeOf(h)];
+    unique_lock<shared_mutex> lock(s.lock);
+
+    for (Node** link = &s.buckets[s.bucketOf(h)]; *link; link = &(*link)->next) {
+        Node* node = *link;
+        if (node->hash == h && KeyEqual{}(node->key, key)) {
+            *link = node->next;
+            s.pool.destroy(node);
+            s.count--;
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool ConcurrentSeparateChainingHashMap<Key, Value, Hash, KeyEqual>::contains(const Key& key) const {
+    size_t h = Hash{}(key);
+    const Stripe& s = stripes[stripeOf(h)];
+    shared_lock<shared_mutex> lock(s.lock);
+    return s.find(key, h) != nullptr;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool ConcurrentSeparateChainingHashMap<Key, Value, Hash, KeyEqual>::tryGet(const Key& key, Value& out) const {
+    size_t h = Hash{}(key);
+    const Stripe& s = stripes[stripeOf(h)];
+    shared_lock<shared_mutex> lock(s.lock);
+    if (Node* node = s.find(key, h)) {
+        out = node->value;
+        return true;
+    }
+    return false;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+Value ConcurrentSeparateChainingHashMap<Key, Value, Hash, KeyEqual>::get(const Key& key) const {
+    Value value;
+    if (!tryGet(key, value)) throw runtime_error("Key not found");
+    return value;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t ConcurrentSeparateChainingHashMap<Key, Value, Hash, KeyEqual>::size() const {
+    size_t total = 0;
+    for (const Stripe& s : stripes) {
+        shared_lock<shared_mutex> lock(s.lock);
+        total += s.count;
+    }
+    return total;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool ConcurrentSeparateChainingHashMap<Key, Value, Hash, KeyEqual>::empty() const {
+    return size() == 0;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t ConcurrentSeparateChainingHashMap<Key, Value, Hash, KeyEqual>::bucketCount() const {
+    size_t total = 0;
+    for (const Stripe& s : stripes) {
+        shared_lock<shared_mutex> lock(s.lock);
+        total += size_t{1} << s.bits;
+    }
+    return total;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+vector<pair<Key, Value>> ConcurrentSeparateChainingHashMap<Key, Value, Hash, KeyEqual>::items() const {
+    vector<pair<Key, Value>> result;
+    forEachEntry([&](const Key& key, const Value& value) {
+        result.push_back({key, value});
+    });
+    return result;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void ConcurrentSeparateChainingHashMap<Key, Value, Hash, KeyEqual>::display() const {
+    forEachEntry([](const Key& key, const Value& value) {
+        cout << key << " : " << value << '\n';
+    });
+}
+
+// Ёмкость сохраняется, блоки пулов остаются для следующих вставок
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void ConcurrentSeparateChainingHashMap<Key, Value, Hash, KeyEqual>::clear() {
+    for (Stripe& s : stripes) {
+        unique_lock<shared_mutex> lock(s.lock);
+        s.destroyNodes();
+        s.pool.reset();
+    }
+}
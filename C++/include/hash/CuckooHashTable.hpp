@@ -0,0 +1,445 @@
+#pragma once
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "HashFunctions.hpp"
+#include "../../json.hpp"
+
+using namespace std;
+
+// Кукушкино хэширование с корзинами: у ключа ровно две корзины по
+// SLOTS ячеек, каждая занимает одну строку кэша. Поиск читает только эти
+// две строки и, если он не пуст, маленький stash. При вставке в полные
+// корзины ключ вытесняет случайного соседа в его другую корзину; путь
+// вытеснений ограничен MAX_KICKS, неудачный остаток уходит в stash.
+// Как в SwissHashMap, у каждой ячейки есть однобайтовая метка хэша,
+// и ключи сравниваются только в ячейках с совпавшей меткой
+template<typename Key, typename Value, typename Hash = FastHash<Key>, typename KeyEqual = equal_to<Key>>
+class CuckooHashMap {
+private:
+    static constexpr size_t CACHE_LINE = 64;
+    static constexpr size_t SLOTS = max<size_t>(4, min<size_t>(8, (CACHE_LINE - sizeof(uint64_t)) / (sizeof(Key) + sizeof(Value))));
+    static constexpr double MAX_LOAD = 0.9;
+    static constexpr size_t MAX_KICKS = 128;
+    static constexpr size_t STASH_SIZE = 8;
+    static constexpr uint64_t LOW_BITS = 0x0101010101010101ull;
+    static constexpr uint64_t HIGH_BITS = 0x8080808080808080ull;
+    static constexpr uint64_t SLOT_BITS = SLOTS == 8 ? HIGH_BITS : HIGH_BITS & ((1ull << (8 * SLOTS)) - 1);
+
+    struct alignas(CACHE_LINE) Bucket {
+        uint64_t tags = 0;  // байт i — метка ячейки i со старшим битом, 0 — ячейка свободна
+        Key keys[SLOTS];
+        Value values[SLOTS];
+
+        // Биты 0x80 в байтах-кандидатах; ложные срабатывания только в занятых ячейках
+        uint64_t match(uint8_t tag) const {
+            uint64_t x = tags ^ (LOW_BITS * tag);
+            return (x - LOW_BITS) & ~x & HIGH_BITS;
+        }
+
+        uint64_t occupied() const { return tags & HIGH_BITS; }
+        uint64_t free() const { return ~tags & SLOT_BITS; }
+        void setTag(size_t i, uint8_t tag) {
+            tags = (tags & ~(0xFFull << (8 * i))) | (static_cast<uint64_t>(tag) << (8 * i));
+        }
+    };
+
+    vector<Bucket> table;
+    vector<pair<Key, Value>> stash;
+    size_t capacity;  // число корзин, степень двойки
+    unsigned bits;
+    size_t count;
+    uint64_t rng;     // xorshift для выбора вытесняемой ячейки
+
+    void setCapacity(size_t buckets);
+    size_t first(size_t h) const;
+    size_t second(size_t h) const;
+    static uint8_t tagOf(size_t h) { return static_cast<uint8_t>(0x80 | (h >> 57)); }
+    static int findSlot(const Bucket& b, uint8_t tag, const Key& key);
+    bool placeFree(size_t bucket, uint8_t tag, Key& key, Value& value);
+    bool kickIn(Key& key, Value& value);
+    void insertNew(Key key, Value value);
+    void drainStash(size_t bucket);
+    void rehash(size_t newCapacity);
+    uint64_t nextRandom();
+
+    // Значение по ключу или nullptr; не больше двух корзин и stash
+    const Value* find(const Key& key) const;
+
+public:
+    CuckooHashMap(size_t cap = 16);
+
+    void put(const Key& key, const Value& value);
+    bool remove(const Key& key);
+    bool contains(const Key& key) const;
+    Value get(const Key& key) const;
+
+    size_t size() const;
+    bool isEmpty() const;
+    size_t getCapacity() const;  // в ячейках
+    size_t stashSize() const;
+    vector<pair<Key, Value>> items() const;
+    void display() const;
+    void clear();
+
+    void to_json(nlohmann::json& j) const {
+        j = nlohmann::json{{"items", nlohmann::json::array()}, {"capacity", getCapacity()}};
+        for (const auto& [key, value] : items()) {
+            j["items"].push_back({{"key", key}, {"value", value}});
+        }
+    }
+
+    void from_json(const nlohmann::json& j) {
+        setCapacity(j.at("capacity").get<size_t>() / SLOTS);
+        count = 0;
+        auto arr = j.at("items");
+        for (size_t i = 0; i < arr.size(); ++i) {
+            put(arr[i]["key"].get<Key>(), arr[i]["value"].get<Value>());
+        }
+    }
+
+    void to_binary(ostream& out) const {
+        // capacity в ячейках, count, затем пары с маркером 1
+        size_t cap = getCapacity();
+        out.write(reinterpret_cast<const char*>(&cap), sizeof(cap));
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        for (const auto& [key, value] : items()) {
+            const char marker = 1;
+            out.write(&marker, 1);
+            out.write(reinterpret_cast<const char*>(&key), sizeof(Key));
+            out.write(reinterpret_cast<const char*>(&value), sizeof(Value));
+        }
+        const char end_marker = 0;
+        out.write(&end_marker, 1);
+    }
+
+    void from_binary(istream& in) {
+        size_t cap = 0, expected = 0;
+        in.read(reinterpret_cast<char*>(&cap), sizeof(cap));
+        in.read(reinterpret_cast<char*>(&expected), sizeof(expected));
+        setCapacity(cap / SLOTS);
+        count = 0;
+        size_t loaded = 0;
+        while (loaded < expected) {
+            char marker = 0;
+            in.read(&marker, 1);
+            if (!in || marker == 0) break;
+            Key k;
+            Value v;
+            in.read(reinterpret_cast<char*>(&k), sizeof(Key));
+            in.read(reinterpret_cast<char*>(&v), sizeof(Value));
+            put(k, v);
+            ++loaded;
+        }
+    }
+};
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+CuckooHashMap<Key, Value, Hash, KeyEqual>::CuckooHashMap(size_t cap) : count(0), rng(hashing::P0) {
+    setCapacity((cap + SLOTS - 1) / SLOTS);
+}
+
+// Число корзин округляется вверх до степени двойки, не меньше 2
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void CuckooHashMap<Key, Value, Hash, KeyEqual>::setCapacity(size_t buckets) {
+    capacity = hashing::roundUpPow2(buckets);
+    bits = hashing::log2Pow2(capacity);
+    table.assign(capacity, Bucket());
+    stash.clear();
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t CuckooHashMap<Key, Value, Hash, KeyEqual>::first(size_t h) const {
+    return hashing::fibonacciIndex(h, bits);
+}
+
+// Первая корзина — старшие биты произведения на 2^64/φ, вторая — младшие
+// биты самого хэша (метка берёт его старшие 7 бит); корзины всегда различны
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t CuckooHashMap<Key, Value, Hash, KeyEqual>::second(size_t h) const {
+    size_t b = h & (capacity - 1);
+    return b == first(h) ? b ^ 1 : b;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+int CuckooHashMap<Key, Value, Hash, KeyEqual>::findSlot(const Bucket& b, uint8_t tag, const Key& key) {
+    for (uint64_t m = b.match(tag); m; m &= m - 1) {
+        int i = __builtin_ctzll(m) >> 3;
+        if (KeyEqual{}(b.keys[i], key)) return i;
+    }
+    return -1;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+uint64_t CuckooHashMap<Key, Value, Hash, KeyEqual>::nextRandom() {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return rng;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+const Value* CuckooHashMap<Key, Value, Hash, KeyEqual>::find(const Key& key) const {
+    size_t h = Hash{}(key);
+    uint8_t tag = tagOf(h);
+    const Bucket& a = table[first(h)];
+    int i = findSlot(a, tag, key);
+    if (i >= 0) return &a.values[i];
+
+    const Bucket& b = table[second(h)];
+    i = findSlot(b, tag, key);
+    if (i >= 0) return &b.values[i];
+
+    for (const auto& entry : stash) {
+        if (KeyEqual{}(entry.first, key)) return &entry.second;
+    }
+    return nullptr;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool CuckooHashMap<Key, Value, Hash, KeyEqual>::placeFree(size_t bucket, uint8_t tag, Key& key, Value& value) {
+    Bucket& b = table[bucket];
+    uint64_t freeSlots = b.free();
+    if (!freeSlots) return false;
+
+    int i = __builtin_ctzll(freeSlots) >> 3;
+    b.keys[i] = move(key);
+    b.values[i] = move(value);
+    b.setTag(i, tag);
+    return true;
+}
+
+// Вставка с вытеснениями. false — путь исчерпан, в key/value остался
+// последний вытесненный элемент (не обязательно исходный)
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool CuckooHashMap<Key, Value, Hash, KeyEqual>::kickIn(Key& key, Value& value) {
+    size_t h = Hash{}(key);
+    uint8_t tag = tagOf(h);
+    size_t b1 = first(h), b2 = second(h);
+    if (placeFree(b1, tag, key, value) || placeFree(b2, tag, key, value)) return true;
+
+    size_t cur = (nextRandom() & 1) ? b1 : b2;
+    for (size_t kick = 0; kick < MAX_KICKS; kick++) {
+        // cur заполнена целиком, любая ячейка занята
+        size_t slot = nextRandom() % SLOTS;
+        Bucket& b = table[cur];
+        swap(key, b.keys[slot]);
+        swap(value, b.values[slot]);
+        b.setTag(slot, tag);
+
+        h = Hash{}(key);
+        tag = tagOf(h);
+        cur = first(h) == cur ? second(h) : first(h);
+        if (placeFree(cur, tag, key, value)) return true;
+    }
+    return false;
+}
+
+// Рост помогает, только если таблица достаточно заполнена: при плохом
+// хэше, когда много ключей делят одни корзины, stash растёт сверх STASH_SIZE
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void CuckooHashMap<Key, Value, Hash, KeyEqual>::insertNew(Key key, Value value) {
+    while (!kickIn(key, value)) {
+        if (stash.size() < STASH_SIZE || count < capacity * SLOTS / 4) {
+            stash.push_back({move(key), move(value)});
+            return;
+        }
+        rehash(capacity * 2);
+    }
+}
+
+// Освободилась ячейка в bucket: туда возвращается подходящий элемент stash
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void CuckooHashMap<Key, Value, Hash, KeyEqual>::drainStash(size_t bucket) {
+    for (size_t i = 0; i < stash.size(); i++) {
+        size_t h = Hash{}(stash[i].first);
+        if (first(h) != bucket && second(h) != bucket) continue;
+
+        placeFree(bucket, tagOf(h), stash[i].first, stash[i].second);
+        stash[i] = move(stash.back());
+        stash.pop_back();
+        return;
+    }
+}
+
+// Все элементы, включая stash, вставляются заново. Вложенный рост внутри
+// insertNew заменяет table, и оставшиеся элементы идут уже в неё
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void CuckooHashMap<Key, Value, Hash, KeyEqual>::rehash(size_t newCapacity) {
+    vector<Bucket> oldTable = move(table);
+    vector<pair<Key, Value>> oldStash = move(stash);
+    setCapacity(newCapacity);
+
+    for (Bucket& b : oldTable) {
+        for (uint64_t m = b.occupied(); m; m &= m - 1) {
+            int i = __builtin_ctzll(m) >> 3;
+            insertNew(move(b.keys[i]), move(b.values[i]));
+        }
+    }
+    for (auto& entry : oldStash) {
+        insertNew(move(entry.first), move(entry.second));
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void CuckooHashMap<Key, Value, Hash, KeyEqual>::put(const Key& key, const Value& value) {
+    if (const Value* found = find(key)) {
+        *const_cast<Value*>(found) = value;
+        return;
+    }
+
+    if (count + 1 > MAX_LOAD * capacity * SLOTS) rehash(capacity * 2);
+    insertNew(key, value);
+    count++;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+Value CuckooHashMap<Key, Value, Hash, KeyEqual>::get(const Key& key) const {
+    const Value* found = find(key);
+    if (!found) throw runtime_error("Key not found");
+    return *found;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool CuckooHashMap<Key, Value, Hash, KeyEqual>::contains(const Key& key) const {
+    return find(key) != nullptr;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool CuckooHashMap<Key, Value, Hash, KeyEqual>::remove(const Key& key) {
+    size_t h = Hash{}(key);
+    for (size_t bucket : {first(h), second(h)}) {
+        int i = findSlot(table[bucket], tagOf(h), key);
+        if (i >= 0) {
+            table[bucket].setTag(i, 0);
+            count--;
+            if (!stash.empty()) drainStash(bucket);
+            return true;
+        }
+    }
+
+    for (size_t i = 0; i < stash.size(); i++) {
+        if (KeyEqual{}(stash[i].first, key)) {
+            stash[i] = move(stash.back());
+            stash.pop_back();
+            count--;
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t CuckooHashMap<Key, Value, Hash, KeyEqual>::size() const {
+    return count;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool CuckooHashMap<Key, Value, Hash, KeyEqual>::isEmpty() const {
+    return count == 0;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t CuckooHashMap<Key, Value, Hash, KeyEqual>::getCapacity() const {
+    return capacity * SLOTS;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t CuckooHashMap<Key, Value, Hash, KeyEqual>::stashSize() const {
+    return stash.size();
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+vector<pair<Key, Value>> CuckooHashMap<Key, Value, Hash, KeyEqual>::items() const {
+    vector<pair<Key, Value>> result;
+    result.reserve(count);
+    for (const Bucket& b : table) {
+        for (uint64_t m = b.occupied(); m; m &= m - 1) {
+            int i = __builtin_ctzll(m) >> 3;
+            result.push_back({b.keys[i], b.values[i]});
+        }
+    }
+    result.insert(result.end(), stash.begin(), stash.end());
+    return result;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void CuckooHashMap<Key, Value, Hash, KeyEqual>::clear() {
+    for (Bucket& b : table) {
+        b.tags = 0;
+    }
+    stash.clear();
+    count = 0;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void CuckooHashMap<Key, Value, Hash, KeyEqual>::display() const {
+    for (const auto& [key, value] : items()) {
+        cout << key << " : " << value << endl;
+    }
+}
+
+// Множество поверх CuckooHashMap с интерфейсом DoubleHashingSet
+template<typename Key, typename Hash = FastHash<Key>, typename KeyEqual = equal_to<Key>>
+class CuckooHashSet {
+private:
+    CuckooHashMap<Key, char, Hash, KeyEqual> map;
+
+public:
+    CuckooHashSet(size_t initialCapacity = 16) : map(initialCapacity) {}
+
+    void push_back(const Key& key) { map.put(key, 0); }
+    bool contains(const Key& key) const { return map.contains(key); }
+    bool remove(const Key& key) { return map.remove(key); }
+    size_t size() const { return map.size(); }
+    size_t getCapacity() const { return map.getCapacity(); }
+    size_t stashSize() const { return map.stashSize(); }
+    void clear() { map.clear(); }
+
+    void display() const {
+        for (const auto& item : map.items()) {
+            cout << item.first << endl;
+        }
+    }
+
+    void to_json(nlohmann::json& j) const {
+        j = nlohmann::json{{"keys", nlohmann::json::array()}, {"capacity", getCapacity()}};
+        for (const auto& item : map.items()) {
+            j["keys"].push_back(item.first);
+        }
+    }
+
+    void from_json(const nlohmann::json& j) {
+        map = CuckooHashMap<Key, char, Hash, KeyEqual>(j.at("capacity").get<size_t>());
+        auto arr = j.at("keys");
+        for (size_t i = 0; i < arr.size(); ++i) {
+            push_back(arr[i].get<Key>());
+        }
+    }
+
+    void to_binary(ostream& out) const {
+        size_t sz = size();
+        size_t cap = getCapacity();
+        out.write(reinterpret_cast<const char*>(&sz), sizeof(sz));
+        out.write(reinterpret_cast<const char*>(&cap), sizeof(cap));
+        for (const auto& item : map.items()) {
+            out.write(reinterpret_cast<const char*>(&item.first), sizeof(Key));
+        }
+    }
+
+    void from_binary(istream& in) {
+        size_t sz = 0, cap = 0;
+        in.read(reinterpret_cast<char*>(&sz), sizeof(sz));
+        in.read(reinterpret_cast<char*>(&cap), sizeof(cap));
+        map = CuckooHashMap<Key, char, Hash, KeyEqual>(cap);
+        for (size_t i = 0; i < sz; ++i) {
+            Key key;
+            in.read(reinterpret_cast<char*>(&key), sizeof(Key));
+            if (!in) break;
+            push_back(key);
+        }
+    }
+};
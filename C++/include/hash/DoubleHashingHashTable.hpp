@@ -2,13 +2,16 @@
 #include <iostream>
 #include <stdexcept>
 #include <vector>
+#include <algorithm>
+#include <utility>
 #include "../ds/Array.hpp"
 
+#include "HashFunctions.hpp"
 #include "../../json.hpp"
 
 using namespace std;
 
-template<typename Key>
+template<typename Key, typename Hash = FastHash<Key>, typename KeyEqual = equal_to<Key>>
 class DoubleHashingSet {
 private:
     static constexpr double LOAD_FACTOR = 0.75; 
@@ -26,18 +29,25 @@ private:
 
     vector<Slot> table;
     size_t currentSize = 0;
-    size_t capacity;
+    size_t deleted = 0;  // ячеек DELETED
+    size_t capacity;  // степень двойки
+    size_t mask;      // capacity - 1
+    unsigned bits;    // log2(capacity)
 
-    size_t hash1(const Key& key) const;
-    size_t hash2(const Key& key) const;
-    size_t probe(const Key& key, size_t i) const;
+    void setCapacity(size_t cap);
+    void probeStart(const Key& key, size_t& idx, size_t& step) const;
+    bool containsFrom(const Key& key, size_t idx, size_t step) const;
     void resize(size_t newCapacity);
+    void insertFresh(Key&& key);
 
 public:
     DoubleHashingSet(size_t initialCapacity = 11);
     void push_back(const Key& key);
     bool contains(const Key& key) const;
+    // Пакетный поиск: out[i] = contains(keys[i])
+    void contains_batch(const Key* keys, size_t n, bool* out) const;
     bool remove(const Key& key);
+    void reserve(size_t n);
     size_t size() const;
     size_t getCapacity() const;
     void display() const;
@@ -54,7 +64,7 @@ public:
 
     void from_json(const nlohmann::json& j) {
         clear();
-        capacity = j.at("capacity").get<size_t>();
+        setCapacity(j.at("capacity").get<size_t>());
         table = vector<Slot>(capacity);
         currentSize = 0;
         auto arr = j.at("keys");
@@ -80,7 +90,7 @@ public:
         size_t sz, loaded_capacity;
         in.read(reinterpret_cast<char*>(&sz), sizeof(sz));
         in.read(reinterpret_cast<char*>(&loaded_capacity), sizeof(loaded_capacity));
-        capacity = loaded_capacity;
+        setCapacity(loaded_capacity);
         table = vector<Slot>(capacity);
         currentSize = 0;
         for (size_t i = 0; i < sz; ++i) {
@@ -94,120 +104,167 @@ public:
     void clear() {
         table = vector<Slot>(capacity);
         currentSize = 0;
+        deleted = 0;
     }
 };
 
-template<typename Key>
-DoubleHashingSet<Key>::DoubleHashingSet(size_t initialCapacity) : table(initialCapacity), capacity(initialCapacity) {}
-
-template<typename Key>
-size_t DoubleHashingSet<Key>::hash1(const Key& key) const {
-    size_t h = 0;
-    if constexpr (is_integral_v<Key>) {
-        h = static_cast<size_t>(key);
-        h = (h ^ (h >> 4)) * 2654435761 % capacity;
-    } else {
-        const string& s = key;
-        for (char c : s) {
-            h = (h * 31 + c);
-        }
-        h = h % capacity;
-    }
-    return h;
+template<typename Key, typename Hash, typename KeyEqual>
+DoubleHashingSet<Key, Hash, KeyEqual>::DoubleHashingSet(size_t initialCapacity) {
+    setCapacity(initialCapacity);
+    table = vector<Slot>(capacity);
 }
 
-template<typename Key>
-size_t DoubleHashingSet<Key>::hash2(const Key& key) const {
-    size_t h = 0;
-    if constexpr (is_integral_v<Key>) {
-        h = static_cast<size_t>(key);
-        h = (h ^ (h >> 3)) * 40503;
-    } else {
-        const string& s = key;
-        for (char c : s) {
-            h = (h * 17 + c);
-        }
-    }
-    return 1 + (h % (capacity - 1));
+// Ёмкость округляется вверх до степени двойки
+template<typename Key, typename Hash, typename KeyEqual>
+void DoubleHashingSet<Key, Hash, KeyEqual>::setCapacity(size_t cap) {
+    capacity = hashing::roundUpPow2(cap);
+    mask = capacity - 1;
+    bits = hashing::log2Pow2(capacity);
 }
 
-template<typename Key>
-size_t DoubleHashingSet<Key>::probe(const Key& key, size_t i) const {
-    return (hash1(key) + i * hash2(key)) % capacity;
+// Хэш считается один раз на операцию: начало — старшие биты произведения,
+// шаг — младшие биты хэша. Нечётный шаг взаимно прост с ёмкостью-степенью
+// двойки, поэтому последовательность idx = (idx + step) & mask обходит все ячейки
+template<typename Key, typename Hash, typename KeyEqual>
+void DoubleHashingSet<Key, Hash, KeyEqual>::probeStart(const Key& key, size_t& idx, size_t& step) const {
+    size_t h = Hash{}(key);
+    idx = hashing::fibonacciIndex(h, bits);
+    step = (h & mask) | 1;
 }
 
-template<typename Key>
-void DoubleHashingSet<Key>::resize(size_t newCapacity) {
-    vector<Slot> oldTable = table;
-    table = vector<Slot>(newCapacity);
-    capacity = newCapacity;
-    currentSize = 0;
+// Единственный путь перестройки — и для роста, и для очистки DELETED
+// (newCapacity == capacity). Старая таблица забирается перемещением, ключи
+// переносятся в новую без проверки заполненности: одновременно живут
+// только две таблицы
+template<typename Key, typename Hash, typename KeyEqual>
+void DoubleHashingSet<Key, Hash, KeyEqual>::resize(size_t newCapacity) {
+    vector<Slot> oldTable = move(table);
+    setCapacity(max(newCapacity, currentSize + 1));
+    table = vector<Slot>(capacity);
+    deleted = 0;
 
-    for (size_t i = 0; i < oldTable.size(); ++i) {
-        if (oldTable[i].status == SlotStatus::OCCUPIED) {
-            push_back(oldTable[i].key);
+    for (Slot& slot : oldTable) {
+        if (slot.status == SlotStatus::OCCUPIED) {
+            insertFresh(move(slot.key));
         }
     }
 }
 
-template<typename Key>
-void DoubleHashingSet<Key>::push_back(const Key& key) {
-    if (static_cast<double>(currentSize) / capacity >= LOAD_FACTOR) {
-        resize(capacity * 2 + 1); 
+// Только для resize: ключа заведомо нет, а в только что созданной таблице
+// нет DELETED, поэтому достаточно дойти до первой пустой ячейки
+template<typename Key, typename Hash, typename KeyEqual>
+void DoubleHashingSet<Key, Hash, KeyEqual>::insertFresh(Key&& key) {
+    size_t idx, step;
+    probeStart(key, idx, step);
+    while (table[idx].status != SlotStatus::EMPTY) {
+        idx = (idx + step) & mask;
+    }
+    table[idx].key = move(key);
+    table[idx].status = SlotStatus::OCCUPIED;
+}
+
+// Ёмкость, при которой n ключей поместятся без роста
+template<typename Key, typename Hash, typename KeyEqual>
+void DoubleHashingSet<Key, Hash, KeyEqual>::reserve(size_t n) {
+    size_t needed = static_cast<size_t>(n / LOAD_FACTOR) + 1;
+    if (needed > capacity) resize(needed);
+}
+
+template<typename Key, typename Hash, typename KeyEqual>
+void DoubleHashingSet<Key, Hash, KeyEqual>::push_back(const Key& key) {
+    // DELETED занимают место наравне с ключами: без них поиск промаха
+    // под постоянными вставками и удалениями доходит до просмотра всей таблицы
+    if (static_cast<double>(currentSize + deleted) / capacity >= LOAD_FACTOR) {
+        // если место заняли в основном DELETED, хватит пересборки без роста
+        size_t newCapacity = (currentSize + 1 > LOAD_FACTOR * capacity / 2) ? capacity * 2 : capacity;
+        resize(newCapacity);
     }
 
+    // ключ может стоять дальше DELETED, поэтому ищем до EMPTY,
+    // а вставляем в первую свободную ячейку
     size_t i = 0;
-    size_t idx;
+    size_t idx, step;
+    probeStart(key, idx, step);
+    size_t freeIdx = capacity;
     do {
-        idx = probe(key, i);
-        if (table[idx].status != SlotStatus::OCCUPIED) {
-            table[idx].key = key;
-            table[idx].status = SlotStatus::OCCUPIED;
-            currentSize++;
-            return;
-        } else if (table[idx].status == SlotStatus::OCCUPIED && table[idx].key == key) {
+        if (table[idx].status == SlotStatus::EMPTY) {
+            if (freeIdx == capacity) freeIdx = idx;
+            break;
+        } else if (table[idx].status == SlotStatus::DELETED) {
+            if (freeIdx == capacity) freeIdx = idx;
+        } else if (KeyEqual{}(table[idx].key, key)) {
             return;
         }
+        idx = (idx + step) & mask;
         ++i;
     } while (i < capacity);
 
-    throw overflow_error("Set is full");
+    if (freeIdx == capacity) throw overflow_error("Set is full");
+
+    if (table[freeIdx].status == SlotStatus::DELETED) deleted--;
+    table[freeIdx].key = key;
+    table[freeIdx].status = SlotStatus::OCCUPIED;
+    currentSize++;
+}
+
+template<typename Key, typename Hash, typename KeyEqual>
+bool DoubleHashingSet<Key, Hash, KeyEqual>::contains(const Key& key) const {
+    size_t idx, step;
+    probeStart(key, idx, step);
+    return containsFrom(key, idx, step);
 }
 
-template<typename Key>
-bool DoubleHashingSet<Key>::contains(const Key& key) const {
+template<typename Key, typename Hash, typename KeyEqual>
+bool DoubleHashingSet<Key, Hash, KeyEqual>::containsFrom(const Key& key, size_t idx, size_t step) const {
     size_t i = 0;
-    size_t idx;
     do {
-        idx = probe(key, i);
         if (table[idx].status == SlotStatus::EMPTY) return false;
-        if (table[idx].status == SlotStatus::OCCUPIED && table[idx].key == key) return true;
+        if (table[idx].status == SlotStatus::OCCUPIED && KeyEqual{}(table[idx].key, key)) return true;
+        idx = (idx + step) & mask;
         ++i;
     } while (i < capacity);
 
     return false;
 }
 
-template<typename Key>
-bool DoubleHashingSet<Key>::remove(const Key& key) {
+template<typename Key, typename Hash, typename KeyEqual>
+void DoubleHashingSet<Key, Hash, KeyEqual>::contains_batch(const Key* keys, size_t n, bool* out) const {
+    size_t idx[hashing::BATCH], step[hashing::BATCH];
+
+    for (size_t base = 0; base < n; base += hashing::BATCH) {
+        size_t len = min(hashing::BATCH, n - base);
+        for (size_t i = 0; i < len; i++) {
+            probeStart(keys[base + i], idx[i], step[i]);
+            hashing::prefetch(&table[idx[i]]);
+        }
+        for (size_t i = 0; i < len; i++) {
+            out[base + i] = containsFrom(keys[base + i], idx[i], step[i]);
+        }
+    }
+}
+
+template<typename Key, typename Hash, typename KeyEqual>
+bool DoubleHashingSet<Key, Hash, KeyEqual>::remove(const Key& key) {
     size_t i = 0;
-    size_t idx;
+    size_t idx, step;
+    probeStart(key, idx, step);
     do {
-        idx = probe(key, i);
         if (table[idx].status == SlotStatus::EMPTY) return false;
-        if (table[idx].status == SlotStatus::OCCUPIED && table[idx].key == key) {
+        if (table[idx].status == SlotStatus::OCCUPIED && KeyEqual{}(table[idx].key, key)) {
             table[idx].status = SlotStatus::DELETED;
             currentSize--;
+            deleted++;
             return true;
         }
+        idx = (idx + step) & mask;
         ++i;
     } while (i < capacity);
 
     return false;
 }
 
-template<typename Key>
-void DoubleHashingSet<Key>::display() const {
+template<typename Key, typename Hash, typename KeyEqual>
+void DoubleHashingSet<Key, Hash, KeyEqual>::display() const {
     for (size_t i = 0; i < capacity; ++i) {
         cout << i << ": ";
         if (table[i].status == SlotStatus::OCCUPIED) {
@@ -221,12 +278,12 @@ void DoubleHashingSet<Key>::display() const {
     }
 }
 
-template<typename Key>
-size_t DoubleHashingSet<Key>::size() const {
+template<typename Key, typename Hash, typename KeyEqual>
+size_t DoubleHashingSet<Key, Hash, KeyEqual>::size() const {
     return this->currentSize;
 }
 
-template<typename Key>
-size_t DoubleHashingSet<Key>::getCapacity() const {
+template<typename Key, typename Hash, typename KeyEqual>
+size_t DoubleHashingSet<Key, Hash, KeyEqual>::getCapacity() const {
     return this->capacity;
 }
\ No newline at end of file
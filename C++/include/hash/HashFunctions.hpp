@@ -0,0 +1,158 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <type_traits>
+
+using namespace std;
+
+// Хэш-функции по умолчанию для хэш-таблиц. std::hash для целых —
+// тождественная функция: последовательные и кратные ключи попадают
+// в соседние или одни и те же ячейки. Здесь все биты результата
+// зависят от всех бит ключа (перемешивание в духе wyhash)
+namespace hashing {
+
+constexpr uint64_t P0 = 0xa0761d6478bd642full;
+constexpr uint64_t P1 = 0xe7037ed1a0b428dbull;
+constexpr uint64_t P2 = 0x8ebc6af09c88c6e3ull;
+constexpr uint64_t P3 = 0x589965cc75374cc3ull;
+
+// 128-битное произведение, свёрнутое в 64 бита
+inline uint64_t mum(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = static_cast<__uint128_t>(a) * b;
+    return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#else
+    uint64_t ha = a >> 32, la = static_cast<uint32_t>(a);
+    uint64_t hb = b >> 32, lb = static_cast<uint32_t>(b);
+    uint64_t hh = ha * hb, hl = ha * lb, lh = la * hb, ll = la * lb;
+    uint64_t mid = (ll >> 32) + static_cast<uint32_t>(hl) + static_cast<uint32_t>(lh);
+    uint64_t lo = (mid << 32) | static_cast<uint32_t>(ll);
+    uint64_t hi = hh + (hl >> 32) + (lh >> 32) + (mid >> 32);
+    return lo ^ hi;
+#endif
+}
+
+inline uint64_t mixInt(uint64_t x) {
+    return mum(x ^ P0, P1);
+}
+
+inline uint64_t read8(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+inline uint64_t read4(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+// Хэш последовательности байт: блоки по 16 байт сворачиваются через mum,
+// короткие строки читаются двумя перекрывающимися словами
+inline uint64_t hashBytes(const void* data, size_t len, uint64_t seed = 0) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    seed ^= mum(seed ^ P0, P1);
+    uint64_t a = 0, b = 0;
+
+    if (len <= 16) {
+        if (len >= 4) {
+            size_t shift = (len >> 3) << 2;
+            a = (read4(p) << 32) | read4(p + shift);
+            b = (read4(p + len - 4) << 32) | read4(p + len - 4 - shift);
+        } else if (len > 0) {
+            a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[len >> 1]) << 8) | p[len - 1];
+        }
+    } else {
+        size_t i = len;
+        if (i > 48) {
+            uint64_t s1 = seed, s2 = seed;
+            do {
+                seed = mum(read8(p) ^ P1, read8(p + 8) ^ seed);
+                s1 = mum(read8(p + 16) ^ P2, read8(p + 24) ^ s1);
+                s2 = mum(read8(p + 32) ^ P3, read8(p + 40) ^ s2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= s1 ^ s2;
+        }
+        while (i > 16) {
+            seed = mum(read8(p) ^ P1, read8(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        a = read8(p + i - 16);
+        b = read8(p + i - 8);
+    }
+
+    return mum(P1 ^ len, mum(a ^ P1, b ^ seed));
+}
+
+// 2^64 / φ, нечётное
+constexpr uint64_t FIBONACCI = 0x9E3779B97F4A7C15ull;
+
+// Наименьшая степень двойки, не меньшая n; не меньше 2
+inline size_t roundUpPow2(size_t n) {
+    size_t result = 2;
+    while (result < n) result <<= 1;
+    return result;
+}
+
+inline unsigned log2Pow2(size_t n) {
+    return static_cast<unsigned>(__builtin_ctzll(n));
+}
+
+// Номер ячейки в таблице из 2^bits ячеек (1 <= bits <= 63): старшие bits
+// бит произведения на 2^64/φ. Деления нет, а старшие биты зависят от всех
+// бит h, поэтому даже тождественный хэш раскладывается по всей таблице
+inline size_t fibonacciIndex(size_t h, unsigned bits) {
+    return static_cast<size_t>((static_cast<uint64_t>(h) * FIBONACCI) >> (64 - bits));
+}
+
+// Пакетный поиск идёт кусками по BATCH ключей: сначала считаются хэши
+// и запрашиваются домашние ячейки всего куска, потом идут сравнения,
+// так что промахи кэша по разным ключам перекрываются
+constexpr size_t BATCH = 16;
+
+inline void prefetch(const void* p) {
+#if defined(__GNUC__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
+}  // namespace hashing
+
+// Хэш по умолчанию: целые и перечисления перемешиваются, строки
+// хэшируются по байтам, остальные типы — перемешанный std::hash
+template<typename T, typename = void>
+struct FastHash {
+    size_t operator()(const T& key) const {
+        return static_cast<size_t>(hashing::mixInt(hash<T>{}(key)));
+    }
+};
+
+template<typename T>
+struct FastHash<T, enable_if_t<is_integral_v<T> || is_enum_v<T>>> {
+    size_t operator()(T key) const {
+        return static_cast<size_t>(hashing::mixInt(static_cast<uint64_t>(key)));
+    }
+};
+
+template<>
+struct FastHash<string> {
+    size_t operator()(const string& key) const {
+        return static_cast<size_t>(hashing::hashBytes(key.data(), key.size()));
+    }
+};
+
+template<>
+struct FastHash<string_view> {
+    size_t operator()(string_view key) const {
+        return static_cast<size_t>(hashing::hashBytes(key.data(), key.size()));
+    }
+};
@@ -1,7 +1,11 @@
 #pragma once
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
+#include <utility>
+#include <vector>
 
+#include "HashFunctions.hpp"
 #include "../../json.hpp"
 
 using namespace std;
@@ -12,7 +16,14 @@ enum class State {
     DELETED
 };
 
-template<typename Key, typename Value>
+// TOMBSTONE — удалённая ячейка помечается DELETED;
+// BACKWARD_SHIFT — следующие элементы кластера сдвигаются на её место
+enum class DeletionMode {
+    TOMBSTONE,
+    BACKWARD_SHIFT
+};
+
+template<typename Key, typename Value, typename Hash = FastHash<Key>, typename KeyEqual = equal_to<Key>>
 class LinearProbingHashMap {
 private:
     struct HashNode {
@@ -23,14 +34,25 @@ private:
         HashNode(const Key& k, const Value& v) : key(k), value(v), state(State::OCCUPIED) {}
     };
 
+    // Порог заполнения с учётом DELETED: выше него таблица пересобирается
+    static constexpr double MAX_LOAD = 0.7;
+
     HashNode* table;
-    size_t capacity;
+    size_t capacity;  // степень двойки
+    size_t mask;      // capacity - 1: переход к следующей ячейке без деления
+    unsigned bits;    // log2(capacity)
     size_t count;
+    size_t deleted;
+    DeletionMode mode;
 
+    void setCapacity(size_t cap);
     size_t hashCode(const Key& key) const;
+    size_t findFrom(size_t idx, const Key& key) const;
+    void rehash(size_t newCapacity);
+    void shiftBack(size_t hole);
 
 public:
-    LinearProbingHashMap(size_t cap = 20);
+    LinearProbingHashMap(size_t cap = 20, DeletionMode mode = DeletionMode::BACKWARD_SHIFT);
     ~LinearProbingHashMap();
 
     void put(const Key& key, const Value& value);
@@ -38,9 +60,18 @@ public:
     bool contains(const Key& key) const;
     Value get(const Key& key) const;
 
+    // Пакетный поиск n ключей: out[i] = contains(keys[i]);
+    // get_batch записывает values[i] только для найденных ключей
+    void contains_batch(const Key* keys, size_t n, bool* out) const;
+    void get_batch(const Key* keys, size_t n, Value* values, bool* found) const;
+
+    vector<pair<Key, Value>> items() const;
     size_t size() const;
     bool isEmpty() const;
+    size_t getCapacity() const;
+    size_t maxProbeLength() const;
     void display() const;
+    void clear();
 
     void to_json(nlohmann::json& j) const {
         j = nlohmann::json{{"items", nlohmann::json::array()}, {"capacity", capacity}};
@@ -53,9 +84,10 @@ public:
 
     void from_json(const nlohmann::json& j) {
         delete[] table;
-        capacity = j.at("capacity").get<size_t>();
+        setCapacity(j.at("capacity").get<size_t>());
         table = new HashNode[capacity];
         count = 0;
+        deleted = 0;
         auto arr = j.at("items");
         for (size_t i = 0; i < arr.size(); ++i) {
             put(arr[i]["key"].get<Key>(), arr[i]["value"].get<Value>());
@@ -81,9 +113,13 @@ public:
 
     void from_binary(istream& in) {
         delete[] table;
-        in.read(reinterpret_cast<char*>(&capacity), sizeof(capacity));
-        in.read(reinterpret_cast<char*>(&count), sizeof(count));
+        size_t cap = 0, expected = 0;
+        in.read(reinterpret_cast<char*>(&cap), sizeof(cap));
+        in.read(reinterpret_cast<char*>(&expected), sizeof(expected));
+        setCapacity(cap);
         table = new HashNode[capacity];
+        count = 0;
+        deleted = 0;
         size_t loaded = 0;
         while (true) {
             char state_marker = 0;
@@ -95,18 +131,18 @@ public:
             in.read(reinterpret_cast<char*>(&v), sizeof(Value));
             put(k, v);
             ++loaded;
-            if (loaded >= count) break;
+            if (loaded >= expected) break;
         }
     }
 };
 
-template<typename Key, typename Value>
-Value LinearProbingHashMap<Key, Value>::get(const Key& key) const {
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+Value LinearProbingHashMap<Key, Value, Hash, KeyEqual>::get(const Key& key) const {
     size_t idx = hashCode(key);
     size_t startIdx = idx;
 
     do {
-        if (table[idx].state == State::OCCUPIED && table[idx].key == key) {
+        if (table[idx].state == State::OCCUPIED && KeyEqual{}(table[idx].key, key)) {
             return table[idx].value;
         }
 
@@ -114,94 +150,252 @@ Value LinearProbingHashMap<Key, Value>::get(const Key& key) const {
             throw runtime_error("Key not found");
         }
 
-        idx = (idx + 1) % capacity;
+        idx = (idx + 1) & mask;
 
     } while (idx != startIdx);
 
     throw runtime_error("Key not found");
 }
 
-template<typename Key, typename Value>
-LinearProbingHashMap<Key, Value>::LinearProbingHashMap(size_t cap) : capacity(cap), count(0) {
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+LinearProbingHashMap<Key, Value, Hash, KeyEqual>::LinearProbingHashMap(size_t cap, DeletionMode mode)
+    : count(0), deleted(0), mode(mode) {
+    setCapacity(cap);
     table = new HashNode[capacity];
 }
 
-template<typename Key, typename Value>
-LinearProbingHashMap<Key, Value>::~LinearProbingHashMap() {
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+LinearProbingHashMap<Key, Value, Hash, KeyEqual>::~LinearProbingHashMap() {
     delete[] table;
 }
 
-template<typename Key, typename Value>
-size_t LinearProbingHashMap<Key, Value>::hashCode(const Key& key) const {
-    return hash<Key>{}(key) % capacity;
+// Ёмкость округляется вверх до степени двойки
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void LinearProbingHashMap<Key, Value, Hash, KeyEqual>::setCapacity(size_t cap) {
+    capacity = hashing::roundUpPow2(cap);
+    mask = capacity - 1;
+    bits = hashing::log2Pow2(capacity);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t LinearProbingHashMap<Key, Value, Hash, KeyEqual>::hashCode(const Key& key) const {
+    return hashing::fibonacciIndex(Hash{}(key), bits);
+}
+
+// Переносит занятые ячейки в новую таблицу; DELETED при этом исчезают
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void LinearProbingHashMap<Key, Value, Hash, KeyEqual>::rehash(size_t newCapacity) {
+    HashNode* oldTable = table;
+    size_t oldCapacity = capacity;
+
+    setCapacity(newCapacity);
+    table = new HashNode[capacity];
+    deleted = 0;
+
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (oldTable[i].state != State::OCCUPIED) continue;
+        size_t idx = hashCode(oldTable[i].key);
+        while (table[idx].state == State::OCCUPIED) {
+            idx = (idx + 1) & mask;
+        }
+        table[idx] = oldTable[i];
+    }
+
+    delete[] oldTable;
 }
 
-template<typename Key, typename Value>
-void LinearProbingHashMap<Key, Value>::put(const Key& key, const Value& value) {
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void LinearProbingHashMap<Key, Value, Hash, KeyEqual>::put(const Key& key, const Value& value) {
+    if (count + deleted + 1 > MAX_LOAD * capacity) {
+        // если место заняли в основном DELETED, хватит пересборки без роста
+        size_t newCapacity = (count + 1 > MAX_LOAD * capacity / 2) ? capacity * 2 : capacity;
+        rehash(newCapacity);
+    }
+
+    // ключ может стоять дальше DELETED, поэтому ищем до EMPTY,
+    // а вставляем в первую свободную ячейку
     size_t idx = hashCode(key);
     size_t startIdx = idx;
+    size_t freeIdx = capacity;
 
     do {
-        if (table[idx].state == State::EMPTY || table[idx].state == State::DELETED) {
-            table[idx] = HashNode(key, value);
-            count++;
-            return;
-        } else if (table[idx].state == State::OCCUPIED && table[idx].key == key) {
+        if (table[idx].state == State::EMPTY) {
+            if (freeIdx == capacity) freeIdx = idx;
+            break;
+        } else if (table[idx].state == State::DELETED) {
+            if (freeIdx == capacity) freeIdx = idx;
+        } else if (KeyEqual{}(table[idx].key, key)) {
             table[idx].value = value;
             return;
         }
-        idx = (idx + 1) % capacity;
+        idx = (idx + 1) & mask;
     } while (idx != startIdx);
 
-    throw runtime_error("Hash table is full");
+    if (freeIdx == capacity) throw runtime_error("Hash table is full");
+
+    if (table[freeIdx].state == State::DELETED) deleted--;
+    table[freeIdx] = HashNode(key, value);
+    count++;
 }
 
-template<typename Key, typename Value>
-bool LinearProbingHashMap<Key, Value>::remove(const Key& key) {
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool LinearProbingHashMap<Key, Value, Hash, KeyEqual>::remove(const Key& key) {
     size_t idx = hashCode(key);
     size_t startIdx = idx;
 
     do {
-        if (table[idx].state == State::OCCUPIED && table[idx].key == key) {
-            table[idx].state = State::DELETED;
+        if (table[idx].state == State::OCCUPIED && KeyEqual{}(table[idx].key, key)) {
             count--;
+            if (mode == DeletionMode::BACKWARD_SHIFT) {
+                shiftBack(idx);
+                return true;
+            }
+            table[idx].state = State::DELETED;
+            deleted++;
+            // чистим DELETED, пока поиск промахов не стал просмотром всей таблицы
+            if (deleted > capacity / 4) rehash(capacity);
             return true;
         }
         if (table[idx].state == State::EMPTY) return false;
-        idx = (idx + 1) % capacity;
+        idx = (idx + 1) & mask;
     } while (idx != startIdx);
 
     return false;
 }
 
-template<typename Key, typename Value>
-bool LinearProbingHashMap<Key, Value>::contains(const Key& key) const {
+// Закрывает дыру в кластере: элемент, чей путь поиска от домашней ячейки
+// проходит через hole, переносится в неё, и дыра переезжает на его место.
+// Кластер остаётся без пропусков, поэтому DELETED не нужны
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void LinearProbingHashMap<Key, Value, Hash, KeyEqual>::shiftBack(size_t hole) {
+    size_t idx = (hole + 1) & mask;
+
+    while (table[idx].state == State::OCCUPIED) {
+        size_t home = hashCode(table[idx].key);
+        bool movable = (idx > hole) ? (home <= hole || home > idx)
+                                    : (home <= hole && home > idx);
+        if (movable) {
+            table[hole] = table[idx];
+            hole = idx;
+        }
+        idx = (idx + 1) & mask;
+    }
+
+    table[hole].state = State::EMPTY;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool LinearProbingHashMap<Key, Value, Hash, KeyEqual>::contains(const Key& key) const {
     size_t idx = hashCode(key);
     size_t startIdx = idx;
 
     do {
-        if (table[idx].state == State::OCCUPIED && table[idx].key == key) {
+        if (table[idx].state == State::OCCUPIED && KeyEqual{}(table[idx].key, key)) {
             return true;
         }
         if (table[idx].state == State::EMPTY) return false;
-        idx = (idx + 1) % capacity;
+        idx = (idx + 1) & mask;
     } while (idx != startIdx);
 
     return false;
 }
 
-template<typename Key, typename Value>
-size_t LinearProbingHashMap<Key, Value>::size() const {
+// Индекс ячейки с ключом при пробировании от idx или capacity, если ключа нет
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t LinearProbingHashMap<Key, Value, Hash, KeyEqual>::findFrom(size_t idx, const Key& key) const {
+    size_t startIdx = idx;
+
+    do {
+        if (table[idx].state == State::OCCUPIED && KeyEqual{}(table[idx].key, key)) return idx;
+        if (table[idx].state == State::EMPTY) return capacity;
+        idx = (idx + 1) & mask;
+    } while (idx != startIdx);
+
+    return capacity;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void LinearProbingHashMap<Key, Value, Hash, KeyEqual>::contains_batch(const Key* keys, size_t n, bool* out) const {
+    size_t home[hashing::BATCH];
+
+    for (size_t base = 0; base < n; base += hashing::BATCH) {
+        size_t len = min(hashing::BATCH, n - base);
+        for (size_t i = 0; i < len; i++) {
+            home[i] = hashCode(keys[base + i]);
+            hashing::prefetch(&table[home[i]]);
+        }
+        for (size_t i = 0; i < len; i++) {
+            out[base + i] = findFrom(home[i], keys[base + i]) != capacity;
+        }
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void LinearProbingHashMap<Key, Value, Hash, KeyEqual>::get_batch(const Key* keys, size_t n, Value* values, bool* found) const {
+    size_t home[hashing::BATCH];
+
+    for (size_t base = 0; base < n; base += hashing::BATCH) {
+        size_t len = min(hashing::BATCH, n - base);
+        for (size_t i = 0; i < len; i++) {
+            home[i] = hashCode(keys[base + i]);
+            hashing::prefetch(&table[home[i]]);
+        }
+        for (size_t i = 0; i < len; i++) {
+            size_t idx = findFrom(home[i], keys[base + i]);
+            found[base + i] = idx != capacity;
+            if (idx != capacity) values[base + i] = table[idx].value;
+        }
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+vector<pair<Key, Value>> LinearProbingHashMap<Key, Value, Hash, KeyEqual>::items() const {
+    vector<pair<Key, Value>> result;
+    result.reserve(count);
+    for (size_t i = 0; i < capacity; i++) {
+        if (table[i].state == State::OCCUPIED) result.push_back({table[i].key, table[i].value});
+    }
+    return result;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t LinearProbingHashMap<Key, Value, Hash, KeyEqual>::size() const {
     return count;
 }
 
-template<typename Key, typename Value>
-bool LinearProbingHashMap<Key, Value>::isEmpty() const {
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool LinearProbingHashMap<Key, Value, Hash, KeyEqual>::isEmpty() const {
     return count == 0;
 }
 
-template<typename Key, typename Value>
-void LinearProbingHashMap<Key, Value>::display() const {
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t LinearProbingHashMap<Key, Value, Hash, KeyEqual>::getCapacity() const {
+    return capacity;
+}
+
+// Наибольшее расстояние от домашней ячейки до занятой ячейки
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t LinearProbingHashMap<Key, Value, Hash, KeyEqual>::maxProbeLength() const {
+    size_t longest = 0;
+    for (size_t i = 0; i < capacity; i++) {
+        if (table[i].state != State::OCCUPIED) continue;
+        size_t home = hashCode(table[i].key);
+        longest = max(longest, (i - home) & mask);
+    }
+    return longest;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void LinearProbingHashMap<Key, Value, Hash, KeyEqual>::clear() {
+    for (size_t i = 0; i < capacity; i++) {
+        table[i].state = State::EMPTY;
+    }
+    count = 0;
+    deleted = 0;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void LinearProbingHashMap<Key, Value, Hash, KeyEqual>::display() const {
     for (size_t i = 0; i < capacity; i++) {
         if (table[i].state == State::OCCUPIED) {
             cout << table[i].key << " : " << table[i].value << endl;
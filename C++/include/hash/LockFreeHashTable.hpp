@@ -0,0 +1,237 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "HashFunctions.hpp"
+#include "../../json.hpp"
+
+using namespace std;
+
+// Множество целых ключей фиксированной ёмкости без блокировок: открытая
+// адресация с линейным пробированием, ячейка — одно 64-битное атомарное
+// слово (состояние в старших битах, ключ в младших 32).
+// Занятая ячейка навсегда остаётся за своим ключом: remove помечает её
+// DELETED вместе с ключом, повторная вставка того же ключа возвращает её
+// в OCCUPIED. Поэтому у ключа не больше одной ячейки, и вставки одного
+// ключа из разных потоков сходятся на ней через CAS.
+// contains только читает ячейки и делает не больше capacity шагов.
+// Ёмкость ограничивает число разных ключей, вставленных за всё время
+// (ячейки с удалёнными ключами не освобождаются). clear, from_json и
+// from_binary нельзя вызывать одновременно с другими операциями
+template<typename Key, typename Hash = FastHash<Key>>
+class LockFreeHashSet {
+    static_assert(is_integral_v<Key> && !is_same_v<Key, bool> && sizeof(Key) <= 4,
+                  "LockFreeHashSet хранит ключ и состояние в одном 64-битном слове");
+
+private:
+    static constexpr uint64_t EMPTY = 0;
+    static constexpr uint64_t OCCUPIED = uint64_t{1} << 32;
+    static constexpr uint64_t DELETED = uint64_t{2} << 32;
+    static constexpr uint64_t KEY_MASK = 0xFFFFFFFFull;
+    // Доля занятых за всё время ячеек, после которой вставки нового ключа отклоняются
+    static constexpr double MAX_LOAD = 0.7;
+
+    unique_ptr<atomic<uint64_t>[]> table;
+    size_t capacity;  // число ячеек, степень двойки
+    size_t mask;
+    unsigned bits;
+    // Ключей в множестве. Со знаком: уменьшение после чужого возврата ключа
+    // из DELETED может прийти раньше его увеличения
+    atomic<long long> count{0};
+    atomic<size_t> claimed{0};  // ячеек, когда-либо занятых ключом
+
+    static uint64_t keyBits(Key key) {
+        return static_cast<uint32_t>(static_cast<make_unsigned_t<Key>>(key));
+    }
+
+    static Key keyOf(uint64_t word) {
+        return static_cast<Key>(static_cast<make_unsigned_t<Key>>(word & KEY_MASK));
+    }
+
+    void allocate(size_t slots);
+    size_t home(Key key) const { return hashing::fibonacciIndex(Hash{}(key), bits); }
+
+public:
+    // Признак для бенчмарка потоков: внешний мьютекс не нужен
+    static constexpr bool concurrent = true;
+
+    // maxKeys — сколько разных ключей может быть вставлено
+    explicit LockFreeHashSet(size_t maxKeys = 1024);
+    LockFreeHashSet(const LockFreeHashSet&) = delete;
+    LockFreeHashSet& operator=(const LockFreeHashSet&) = delete;
+
+    void push_back(const Key& key);
+    bool contains(const Key& key) const;
+    bool remove(const Key& key);
+    size_t size() const;
+    size_t getCapacity() const;
+    void display() const;
+    void clear();
+
+    void to_json(nlohmann::json& j) const {
+        j = nlohmann::json{{"keys", nlohmann::json::array()}, {"capacity", capacity}};
+        for (size_t i = 0; i < capacity; ++i) {
+            uint64_t word = table[i].load(memory_order_acquire);
+            if ((word & ~KEY_MASK) == OCCUPIED) j["keys"].push_back(keyOf(word));
+        }
+    }
+
+    void from_json(const nlohmann::json& j) {
+        allocate(j.at("capacity").get<size_t>());
+        auto arr = j.at("keys");
+        for (size_t i = 0; i < arr.size(); ++i) {
+            push_back(arr[i].get<Key>());
+        }
+    }
+
+    void to_binary(ostream& out) const {
+        // число ключей, capacity, затем ключи — как в DoubleHashingSet
+        vector<Key> keys;
+        for (size_t i = 0; i < capacity; ++i) {
+            uint64_t word = table[i].load(memory_order_acquire);
+            if ((word & ~KEY_MASK) == OCCUPIED) keys.push_back(keyOf(word));
+        }
+        size_t sz = keys.size();
+        out.write(reinterpret_cast<const char*>(&sz), sizeof(sz));
+        out.write(reinterpret_cast<const char*>(&capacity), sizeof(capacity));
+        for (Key key : keys) {
+            out.write(reinterpret_cast<const char*>(&key), sizeof(Key));
+        }
+    }
+
+    void from_binary(istream& in) {
+        size_t sz = 0, loaded_capacity = 0;
+        in.read(reinterpret_cast<char*>(&sz), sizeof(sz));
+        in.read(reinterpret_cast<char*>(&loaded_capacity), sizeof(loaded_capacity));
+        allocate(loaded_capacity);
+        for (size_t i = 0; i < sz; ++i) {
+            Key key;
+            in.read(reinterpret_cast<char*>(&key), sizeof(Key));
+            if (!in) break;
+            push_back(key);
+        }
+    }
+};
+
+template<typename Key, typename Hash>
+LockFreeHashSet<Key, Hash>::LockFreeHashSet(size_t maxKeys) {
+    allocate(static_cast<size_t>(maxKeys / MAX_LOAD) + 1);
+}
+
+// Новая пустая таблица на roundUpPow2(slots) ячеек
+template<typename Key, typename Hash>
+void LockFreeHashSet<Key, Hash>::allocate(size_t slots) {
+    capacity = hashing::roundUpPow2(slots);
+    mask = capacity - 1;
+    bits = hashing::log2Pow2(capacity);
+    table.reset(new atomic<uint64_t>[capacity]);
+    clear();
+}
+
+template<typename Key, typename Hash>
+void LockFreeHashSet<Key, Hash>::push_back(const Key& key) {
+    const uint64_t bitsOfKey = keyBits(key);
+    size_t idx = home(key);
+
+    for (size_t i = 0; i < capacity; i++, idx = (idx + 1) & mask) {
+        uint64_t word = table[idx].load(memory_order_acquire);
+
+        if (word == EMPTY) {
+            if (claimed.load(memory_order_relaxed) >= MAX_LOAD * capacity) {
+                throw overflow_error("Set is full");
+            }
+            if (table[idx].compare_exchange_strong(word, OCCUPIED | bitsOfKey, memory_order_acq_rel)) {
+                claimed.fetch_add(1, memory_order_relaxed);
+                count.fetch_add(1, memory_order_relaxed);
+                return;
+            }
+            // ячейку занял другой поток; word — её новое содержимое
+        }
+
+        if ((word & KEY_MASK) != bitsOfKey) continue;  // ячейка другого ключа
+
+        // ячейка этого ключа: вернуть из DELETED, если нужно
+        while (word == (DELETED | bitsOfKey)) {
+            if (table[idx].compare_exchange_weak(word, OCCUPIED | bitsOfKey, memory_order_acq_rel)) {
+                count.fetch_add(1, memory_order_relaxed);
+                return;
+            }
+        }
+        return;  // ключ уже есть
+    }
+
+    throw overflow_error("Set is full");
+}
+
+template<typename Key, typename Hash>
+bool LockFreeHashSet<Key, Hash>::contains(const Key& key) const {
+    const uint64_t bitsOfKey = keyBits(key);
+    size_t idx = home(key);
+
+    for (size_t i = 0; i < capacity; i++, idx = (idx + 1) & mask) {
+        uint64_t word = table[idx].load(memory_order_acquire);
+        if (word == EMPTY) return false;
+        if ((word & KEY_MASK) == bitsOfKey) return word == (OCCUPIED | bitsOfKey);
+    }
+    return false;
+}
+
+template<typename Key, typename Hash>
+bool LockFreeHashSet<Key, Hash>::remove(const Key& key) {
+    const uint64_t bitsOfKey = keyBits(key);
+    size_t idx = home(key);
+
+    for (size_t i = 0; i < capacity; i++, idx = (idx + 1) & mask) {
+        uint64_t word = table[idx].load(memory_order_acquire);
+        if (word == EMPTY) return false;
+        if ((word & KEY_MASK) != bitsOfKey) continue;
+
+        while (word == (OCCUPIED | bitsOfKey)) {
+            if (table[idx].compare_exchange_weak(word, DELETED | bitsOfKey, memory_order_acq_rel)) {
+                count.fetch_sub(1, memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;  // уже удалён
+    }
+    return false;
+}
+
+template<typename Key, typename Hash>
+size_t LockFreeHashSet<Key, Hash>::size() const {
+    long long n = count.load(memory_order_relaxed);
+    return n > 0 ? static_cast<size_t>(n) : 0;
+}
+
+template<typename Key, typename Hash>
+size_t LockFreeHashSet<Key, Hash>::getCapacity() const {
+    return capacity;
+}
+
+template<typename Key, typename Hash>
+void LockFreeHashSet<Key, Hash>::clear() {
+    for (size_t i = 0; i < capacity; i++) table[i].store(EMPTY, memory_order_relaxed);
+    count.store(0, memory_order_relaxed);
+    claimed.store(0, memory_order_relaxed);
+}
+
+template<typename Key, typename Hash>
+void LockFreeHashSet<Key, Hash>::display() const {
+    for (size_t i = 0; i < capacity; ++i) {
+        uint64_t word = table[i].load(memory_order_acquire);
+        cout << i << ": ";
+        if (word == EMPTY) {
+            cout << "EMPTY";
+        } else if ((word & ~KEY_MASK) == DELETED) {
+            cout << "DELETED";
+        } else {
+            cout << keyOf(word);
+        }
+        cout << endl;
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Пул узлов одного типа: память берётся блоками (slab) из всё большего
+// числа узлов, освобождённые узлы уходят в список свободных и выдаются
+// первыми. Узлы лежат в памяти подряд и без заголовков malloc, а вставка
+// не обращается к общему аллокатору, пока не кончится текущий блок
+template<typename T>
+class NodePool {
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static constexpr size_t FIRST_SLAB = 64;
+    static constexpr size_t MAX_SLAB = 1 << 16;
+
+    vector<pair<Slot*, size_t>> slabs;  // блок и число узлов в нём
+    Slot* freeList;
+    size_t used;     // выдано узлов из последнего блока
+    size_t live;
+
+    void addSlab() {
+        size_t n = slabs.empty() ? FIRST_SLAB : min(slabs.back().second * 2, MAX_SLAB);
+        slabs.push_back({static_cast<Slot*>(::operator new(n * sizeof(Slot))), n});
+        used = 0;
+    }
+
+public:
+    NodePool() : freeList(nullptr), used(0), live(0) {}
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    ~NodePool() { release(); }
+
+    template<typename... Args>
+    T* create(Args&&... args) {
+        Slot* slot;
+        if (freeList) {
+            slot = freeList;
+            freeList = freeList->next;
+        } else {
+            if (slabs.empty() || used == slabs.back().second) addSlab();
+            slot = &slabs.back().first[used++];
+        }
+        live++;
+        return new (slot->storage) T(forward<Args>(args)...);
+    }
+
+    void destroy(T* node) {
+        node->~T();
+        Slot* slot = reinterpret_cast<Slot*>(node);
+        slot->next = freeList;
+        freeList = slot;
+        live--;
+    }
+
+    // Все узлы снова свободны, блоки остаются для повторного заполнения.
+    // Деструкторы узлов к этому моменту должны быть вызваны
+    void reset() {
+        if (slabs.empty()) return;
+        // оставляем самый большой блок, остальные отдаём
+        for (size_t i = 0; i + 1 < slabs.size(); i++) {
+            ::operator delete(slabs[i].first);
+        }
+        slabs.erase(slabs.begin(), slabs.end() - 1);
+        freeList = nullptr;
+        used = 0;
+        live = 0;
+    }
+
+    // Вся память пула возвращается аллокатору
+    void release() {
+        for (auto& slab : slabs) {
+            ::operator delete(slab.first);
+        }
+        slabs.clear();
+        freeList = nullptr;
+        used = 0;
+        live = 0;
+    }
+
+    size_t liveNodes() const { return live; }
+
+    size_t reservedNodes() const {
+        size_t total = 0;
+        for (const auto& slab : slabs) total += slab.second;
+        return total;
+    }
+};
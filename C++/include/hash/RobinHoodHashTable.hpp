@@ -0,0 +1,270 @@
+#pragma once
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+
+#include "HashFunctions.hpp"
+#include "../../json.hpp"
+
+using namespace std;
+
+// Открытая адресация с линейным пробированием по схеме Robin Hood:
+// при вставке элемент, ушедший от своей ячейки дальше, занимает место
+// у элемента, ушедшего меньше. Расстояния выравниваются, поэтому
+// поиск отсутствующего ключа заканчивается, как только расстояние
+// в ячейке становится меньше пройденного
+template<typename Key, typename Value, typename Hash = FastHash<Key>, typename KeyEqual = equal_to<Key>>
+class RobinHoodHashMap {
+private:
+    struct HashNode {
+        Key key;
+        Value value;
+        int dist;  // расстояние от домашней ячейки, -1 — ячейка пуста
+        HashNode() : dist(-1) {}
+        HashNode(const Key& k, const Value& v, int d) : key(k), value(v), dist(d) {}
+    };
+
+    static constexpr double MAX_LOAD = 0.85;
+
+    HashNode* table;
+    size_t capacity;  // степень двойки
+    size_t mask;
+    unsigned bits;
+    size_t count;
+
+    void setCapacity(size_t cap);
+    size_t hashCode(const Key& key) const;
+    size_t findIndex(const Key& key) const;
+    void insertNode(HashNode node);
+    void rehash(size_t newCapacity);
+
+public:
+    RobinHoodHashMap(size_t cap = 20);
+    ~RobinHoodHashMap();
+    RobinHoodHashMap(const RobinHoodHashMap&) = delete;
+    RobinHoodHashMap& operator=(const RobinHoodHashMap&) = delete;
+
+    void put(const Key& key, const Value& value);
+    bool remove(const Key& key);
+    bool contains(const Key& key) const;
+    Value get(const Key& key) const;
+
+    size_t size() const;
+    bool isEmpty() const;
+    size_t getCapacity() const;
+    size_t maxProbeLength() const;
+    void display() const;
+    void clear();
+
+    void to_json(nlohmann::json& j) const {
+        j = nlohmann::json{{"items", nlohmann::json::array()}, {"capacity", capacity}};
+        for (size_t i = 0; i < capacity; ++i) {
+            if (table[i].dist >= 0) {
+                j["items"].push_back({{"key", table[i].key}, {"value", table[i].value}});
+            }
+        }
+    }
+
+    void from_json(const nlohmann::json& j) {
+        delete[] table;
+        setCapacity(j.at("capacity").get<size_t>());
+        table = new HashNode[capacity];
+        count = 0;
+        auto arr = j.at("items");
+        for (size_t i = 0; i < arr.size(); ++i) {
+            put(arr[i]["key"].get<Key>(), arr[i]["value"].get<Value>());
+        }
+    }
+
+    void to_binary(ostream& out) const {
+        // capacity, count, затем занятые ячейки с маркером 1
+        out.write(reinterpret_cast<const char*>(&capacity), sizeof(capacity));
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        for (size_t i = 0; i < capacity; ++i) {
+            if (table[i].dist >= 0) {
+                const char marker = 1;
+                out.write(&marker, 1);
+                out.write(reinterpret_cast<const char*>(&table[i].key), sizeof(Key));
+                out.write(reinterpret_cast<const char*>(&table[i].value), sizeof(Value));
+            }
+        }
+        const char end_marker = 0;
+        out.write(&end_marker, 1);
+    }
+
+    void from_binary(istream& in) {
+        delete[] table;
+        size_t cap = 0, expected = 0;
+        in.read(reinterpret_cast<char*>(&cap), sizeof(cap));
+        in.read(reinterpret_cast<char*>(&expected), sizeof(expected));
+        setCapacity(cap);
+        table = new HashNode[capacity];
+        count = 0;
+        size_t loaded = 0;
+        while (loaded < expected) {
+            char marker = 0;
+            in.read(&marker, 1);
+            if (!in || marker == 0) break;
+            Key k;
+            Value v;
+            in.read(reinterpret_cast<char*>(&k), sizeof(Key));
+            in.read(reinterpret_cast<char*>(&v), sizeof(Value));
+            put(k, v);
+            ++loaded;
+        }
+    }
+};
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+RobinHoodHashMap<Key, Value, Hash, KeyEqual>::RobinHoodHashMap(size_t cap) : count(0) {
+    setCapacity(cap);
+    table = new HashNode[capacity];
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+RobinHoodHashMap<Key, Value, Hash, KeyEqual>::~RobinHoodHashMap() {
+    delete[] table;
+}
+
+// Ёмкость округляется вверх до степени двойки
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void RobinHoodHashMap<Key, Value, Hash, KeyEqual>::setCapacity(size_t cap) {
+    capacity = hashing::roundUpPow2(cap);
+    mask = capacity - 1;
+    bits = hashing::log2Pow2(capacity);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t RobinHoodHashMap<Key, Value, Hash, KeyEqual>::hashCode(const Key& key) const {
+    return hashing::fibonacciIndex(Hash{}(key), bits);
+}
+
+// Индекс ячейки с ключом или capacity, если ключа нет
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t RobinHoodHashMap<Key, Value, Hash, KeyEqual>::findIndex(const Key& key) const {
+    size_t idx = hashCode(key);
+
+    for (int d = 0; d <= table[idx].dist; d++) {
+        if (table[idx].dist == d && KeyEqual{}(table[idx].key, key)) return idx;
+        idx = (idx + 1) & mask;
+    }
+
+    return capacity;
+}
+
+// Вставка ключа, которого заведомо нет в таблице
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void RobinHoodHashMap<Key, Value, Hash, KeyEqual>::insertNode(HashNode node) {
+    size_t idx = hashCode(node.key);
+    node.dist = 0;
+
+    while (table[idx].dist >= 0) {
+        if (table[idx].dist < node.dist) swap(node, table[idx]);
+        idx = (idx + 1) & mask;
+        node.dist++;
+    }
+
+    table[idx] = node;
+    count++;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void RobinHoodHashMap<Key, Value, Hash, KeyEqual>::rehash(size_t newCapacity) {
+    HashNode* oldTable = table;
+    size_t oldCapacity = capacity;
+
+    setCapacity(newCapacity);
+    table = new HashNode[capacity];
+    count = 0;
+
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (oldTable[i].dist >= 0) insertNode(oldTable[i]);
+    }
+
+    delete[] oldTable;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void RobinHoodHashMap<Key, Value, Hash, KeyEqual>::put(const Key& key, const Value& value) {
+    size_t idx = findIndex(key);
+    if (idx != capacity) {
+        table[idx].value = value;
+        return;
+    }
+
+    if (count + 1 > MAX_LOAD * capacity) rehash(capacity * 2);
+    insertNode(HashNode(key, value, 0));
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+Value RobinHoodHashMap<Key, Value, Hash, KeyEqual>::get(const Key& key) const {
+    size_t idx = findIndex(key);
+    if (idx == capacity) throw runtime_error("Key not found");
+    return table[idx].value;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool RobinHoodHashMap<Key, Value, Hash, KeyEqual>::contains(const Key& key) const {
+    return findIndex(key) != capacity;
+}
+
+// Следующие элементы кластера сдвигаются на одну ячейку назад,
+// пока не встретится пустая ячейка или элемент в своей домашней
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool RobinHoodHashMap<Key, Value, Hash, KeyEqual>::remove(const Key& key) {
+    size_t idx = findIndex(key);
+    if (idx == capacity) return false;
+
+    size_t next = (idx + 1) & mask;
+    while (table[next].dist > 0) {
+        table[idx] = table[next];
+        table[idx].dist--;
+        idx = next;
+        next = (next + 1) & mask;
+    }
+
+    table[idx].dist = -1;
+    count--;
+    return true;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t RobinHoodHashMap<Key, Value, Hash, KeyEqual>::size() const {
+    return count;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool RobinHoodHashMap<Key, Value, Hash, KeyEqual>::isEmpty() const {
+    return count == 0;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t RobinHoodHashMap<Key, Value, Hash, KeyEqual>::getCapacity() const {
+    return capacity;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t RobinHoodHashMap<Key, Value, Hash, KeyEqual>::maxProbeLength() const {
+    int longest = 0;
+    for (size_t i = 0; i < capacity; i++) {
+        longest = max(longest, table[i].dist);
+    }
+    return static_cast<size_t>(longest);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void RobinHoodHashMap<Key, Value, Hash, KeyEqual>::clear() {
+    for (size_t i = 0; i < capacity; i++) {
+        table[i].dist = -1;
+    }
+    count = 0;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void RobinHoodHashMap<Key, Value, Hash, KeyEqual>::display() const {
+    for (size_t i = 0; i < capacity; i++) {
+        if (table[i].dist >= 0) {
+            cout << table[i].key << " : " << table[i].value << endl;
+        }
+    }
+}
@@ -1,34 +1,124 @@
 #pragma once
+#include <cstdint>
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <new>
 #include <stdexcept>
 #include <vector>
+#include <utility>
+#include <type_traits>
 
+#include "HashFunctions.hpp"
+#include "NodePool.hpp"
 #include "../../json.hpp"
 
 using namespace std;
 
-template<typename Key, typename Value>
+// FULL — вся таблица перестраивается внутри одного put.
+// INCREMENTAL — старая таблица сохраняется, и каждая изменяющая операция
+// переносит из неё не больше MIGRATE_STEP корзин
+enum class RehashMode { FULL, INCREMENTAL };
+
+// Корзина занимает строку кэша: первые пары хранятся прямо в ней,
+// и только переполненная корзина продолжается цепочкой узлов из пула.
+// Поиск обычно обходится одним промахом кэша вместо перехода по указателям,
+// а однобайтовые метки хэша отсеивают чужие ключи без их сравнения.
+// Ссылки из get действительны до следующего изменения таблицы
+template<typename Key, typename Value, typename Hash = FastHash<Key>, typename KeyEqual = equal_to<Key>>
 class SeparateChainingHashMap {
 private:
     struct Node {
         Key key;
         Value value;
         Node* next;
-        Node(const Key& k, const Value& v) : key(k), value(v), next(nullptr) {}
+        template<typename K, typename V>
+        Node(K&& k, V&& v) : key(forward<K>(k)), value(forward<V>(v)), next(nullptr) {}
     };
 
-    const double LOAD_FACTOR = 0.75;
+    struct Entry {
+        Key key;
+        Value value;
+    };
 
-    size_t capacity_;
-    size_t size_;
-    vector<Node*> table;
+    static constexpr size_t CACHE_LINE = 64;
+    static constexpr size_t HEADER = sizeof(Node*) + sizeof(uint64_t);
+    static constexpr size_t INLINE = sizeof(Entry) + HEADER <= CACHE_LINE ? min<size_t>(8, (CACHE_LINE - HEADER) / sizeof(Entry)) : 1;
+    static constexpr uint64_t LOW_BITS = 0x0101010101010101ull;
+    static constexpr uint64_t HIGH_BITS = 0x8080808080808080ull;
+
+    struct alignas(CACHE_LINE) Bucket {
+        // Нулевые байты — пустая корзина
+        Node* overflow;  // есть только при заполненных встроенных ячейках
+        uint64_t tags;   // байт i — метка ячейки i со старшим битом, 0 — ячейка свободна
+        alignas(Entry) unsigned char slots[INLINE * sizeof(Entry)];
+
+        Entry* at(size_t i) { return launder(reinterpret_cast<Entry*>(slots) + i); }
+        const Entry* at(size_t i) const { return launder(reinterpret_cast<const Entry*>(slots) + i); }
+
+        // Ячейки заняты подряд с начала, поэтому их число — номер старшего ненулевого байта + 1
+        size_t used() const { return tags ? (71 - __builtin_clzll(tags)) / 8 : 0; }
+
+        // Биты 0x80 в байтах, где метка может совпадать с tag. Ложные
+        // срабатывания возможны только в занятых ячейках, ключ всё равно сравнивается
+        uint64_t match(uint8_t tag) const {
+            uint64_t x = tags ^ (LOW_BITS * tag);
+            return (x - LOW_BITS) & ~x & HIGH_BITS;
+        }
+
+        void setTag(size_t i, uint8_t tag) {
+            tags = (tags & ~(0xFFull << (8 * i))) | (static_cast<uint64_t>(tag) << (8 * i));
+        }
+    };
+
+    // Среднее число пар на корзину: половина встроенных ячеек
+    const double LOAD_FACTOR = INLINE > 1 ? INLINE * 0.5 : 0.75;
+    static constexpr size_t MIGRATE_STEP = 4;
 
-    size_t hash(const Key& key) const;
+    size_t capacity_;  // число корзин, степень двойки
+    unsigned bits_;    // log2(capacity_)
+    size_t size_;
+    unique_ptr<Bucket[]> table;
+    NodePool<Node> pool;  // узлы переполнения
+
+    // Во время переноса: корзины oldTable (capacity_ / 2 штук) с номером
+    // >= migrated_ ещё не перенесены. Старая корзина i распадается на новые
+    // 2i и 2i+1, и они обнуляются только при её переносе: rehash не
+    // заполняет новую таблицу целиком
+    unique_ptr<Bucket[]> oldTable;
+    size_t migrated_;
+    RehashMode mode_;
+
+    static uint8_t tagOf(size_t h) { return static_cast<uint8_t>(0x80 | (h & 0x7F)); }
+    size_t index(size_t h) const;
+    const Bucket& bucket(size_t h) const;
+    Bucket& bucket(size_t h) { return const_cast<Bucket&>(as_const(*this).bucket(h)); }
+    const Value* find(const Key& key, size_t h) const;
+    template<typename K, typename V>
+    void place(Bucket& b, uint8_t tag, K&& key, V&& value);
+    void moveBucket(Bucket& from, Bucket* to);
+    void destroyEntries(Bucket* t, size_t from, size_t to);
+    size_t readyBuckets() const;
     void rehash();
+    void migrateStep();
+    void copyBuckets(const Bucket* from, size_t count, unique_ptr<Bucket[]>& to, size_t size);
+
+    template<typename F>
+    void forEachEntry(F f) const {
+        auto visit = [&](const Bucket& b) {
+            for (size_t i = 0; i < b.used(); i++) f(b.at(i)->key, b.at(i)->value);
+            for (Node* node = b.overflow; node; node = node->next) f(node->key, node->value);
+        };
+        for (size_t i = 0; i < readyBuckets(); i++) visit(table[i]);
+        if (isRehashing()) {
+            for (size_t i = migrated_; i < capacity_ / 2; i++) visit(oldTable[i]);
+        }
+    }
 
 public:
-    SeparateChainingHashMap(size_t initialCapacity = 11)
-        : capacity_(initialCapacity), size_(0), table(capacity_, nullptr) {}
+    SeparateChainingHashMap(size_t initialCapacity = 11, RehashMode mode = RehashMode::FULL)
+        : capacity_(hashing::roundUpPow2(initialCapacity)), bits_(hashing::log2Pow2(capacity_)),
+          size_(0), table(new Bucket[capacity_]()), migrated_(0), mode_(mode) {}
     SeparateChainingHashMap(const SeparateChainingHashMap& other);
     ~SeparateChainingHashMap();
 
@@ -42,26 +132,30 @@ public:
     
     void display() const;
     bool empty() const;
+    size_t size() const;
     bool contains(const Key& key) const;
-    void clear();
+    // Пакетный поиск n ключей: out[i] = contains(keys[i]);
+    // get_batch записывает values[i] только для найденных ключей
+    void contains_batch(const Key* keys, size_t n, bool* out) const;
+    void get_batch(const Key* keys, size_t n, Value* values, bool* found) const;
+    // releaseMemory = false оставляет блоки пула для следующих вставок
+    void clear(bool releaseMemory = false);
+    bool isRehashing() const;
 
-    SeparateChainingHashMap<Key, Value>& operator=(const SeparateChainingHashMap& other);
+    SeparateChainingHashMap& operator=(const SeparateChainingHashMap& other);
 
     void to_json(nlohmann::json& j) const {
         j = nlohmann::json{{"items", nlohmann::json::array()}, {"capacity", capacity_}};
-        for (size_t i = 0; i < capacity_; ++i) {
-            Node* node = table[i];
-            while (node) {
-                j["items"].push_back({{"key", node->key}, {"value", node->value}});
-                node = node->next;
-            }
-        }
+        forEachEntry([&](const Key& key, const Value& value) {
+            j["items"].push_back({{"key", key}, {"value", value}});
+        });
     }
 
     void from_json(const nlohmann::json& j) {
         clear();
-        capacity_ = j.at("capacity").get<size_t>();
-        table.assign(capacity_, nullptr);
+        capacity_ = hashing::roundUpPow2(j.at("capacity").get<size_t>());
+        bits_ = hashing::log2Pow2(capacity_);
+        table.reset(new Bucket[capacity_]());
         size_ = 0;
         auto arr = j.at("items");
         for (size_t i = 0; i < arr.size(); ++i) {
@@ -74,14 +168,10 @@ public:
         out.write(reinterpret_cast<const char*>(&capacity_), sizeof(capacity_));
         out.write(reinterpret_cast<const char*>(&size_), sizeof(size_));
         // key, value
-        for (size_t i = 0; i < capacity_; ++i) {
-            Node* node = table[i];
-            while (node) {
-                out.write(reinterpret_cast<const char*>(&node->key), sizeof(Key));
-                out.write(reinterpret_cast<const char*>(&node->value), sizeof(Value));
-                node = node->next;
-            }
-        }
+        forEachEntry([&](const Key& key, const Value& value) {
+            out.write(reinterpret_cast<const char*>(&key), sizeof(Key));
+            out.write(reinterpret_cast<const char*>(&value), sizeof(Value));
+        });
     }
 
     void from_binary(istream& in) {
@@ -89,8 +179,9 @@ public:
         size_t loaded_capacity = 0, sz = 0;
         in.read(reinterpret_cast<char*>(&loaded_capacity), sizeof(loaded_capacity));
         in.read(reinterpret_cast<char*>(&sz), sizeof(sz));
-        capacity_ = loaded_capacity;
-        table.assign(capacity_, nullptr);
+        capacity_ = hashing::roundUpPow2(loaded_capacity);
+        bits_ = hashing::log2Pow2(capacity_);
+        table.reset(new Bucket[capacity_]());
         size_ = 0;
         for (size_t i = 0; i < sz; ++i) {
             Key key;
@@ -103,215 +194,381 @@ public:
     }
 };
 
-template<typename Key, typename Value>
-bool SeparateChainingHashMap<Key, Value>::contains(const Key& key) const {
-    size_t idx = hash(key) % capacity_;
-    Node* node = table[idx];
-    while (node) {
-        if (node->key == key) {
-            return true;
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::contains(const Key& key) const {
+    return find(key, Hash{}(key)) != nullptr;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::contains_batch(const Key* keys, size_t n, bool* out) const {
+    size_t h[hashing::BATCH];
+
+    for (size_t base = 0; base < n; base += hashing::BATCH) {
+        size_t len = min(hashing::BATCH, n - base);
+        for (size_t i = 0; i < len; i++) {
+            h[i] = Hash{}(keys[base + i]);
+            hashing::prefetch(&bucket(h[i]));
+        }
+        for (size_t i = 0; i < len; i++) {
+            out[base + i] = find(keys[base + i], h[i]) != nullptr;
         }
-        node = node->next;
     }
-    return false;
 }
 
-template<typename Key, typename Value>
-void SeparateChainingHashMap<Key, Value>::display() const {
-    for (size_t i = 0; i < capacity_; ++i) {
-        cout << i << ": ";
-        Node* node = table[i];
-        if (!node) {
-            cout << "EMPTY";
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::get_batch(const Key* keys, size_t n, Value* values, bool* found) const {
+    size_t h[hashing::BATCH];
+
+    for (size_t base = 0; base < n; base += hashing::BATCH) {
+        size_t len = min(hashing::BATCH, n - base);
+        for (size_t i = 0; i < len; i++) {
+            h[i] = Hash{}(keys[base + i]);
+            hashing::prefetch(&bucket(h[i]));
         }
-        while (node) {
-            cout << "(" << node->key << " -> " << node->value << ")";
-            if (node->next) cout << " -> ";
-            node = node->next;
+        for (size_t i = 0; i < len; i++) {
+            const Value* value = find(keys[base + i], h[i]);
+            found[base + i] = value != nullptr;
+            if (value) values[base + i] = *value;
         }
-        cout << '\n';
     }
 }
 
-template<typename Key, typename Value>
-SeparateChainingHashMap<Key, Value>::SeparateChainingHashMap(const SeparateChainingHashMap& other)
-    : capacity_(other.capacity_), size_(other.size_), table(capacity_, nullptr) {
-    for (size_t i = 0; i < capacity_; i++) {
-        Node* node = other.table[i];
-        Node** last = &table[i];
-        while (node) {
-            *last = new Node(node->key, node->value);
-            last = &((*last)->next);
-            node = node->next;
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::display() const {
+    auto show = [](const Bucket* t, size_t from, size_t to, const char* prefix) {
+        for (size_t i = from; i < to; ++i) {
+            const Bucket& b = t[i];
+            cout << prefix << i << ": ";
+            if (b.used() == 0) {
+                cout << "EMPTY";
+            }
+            for (size_t k = 0; k < b.used(); k++) {
+                if (k > 0) cout << " -> ";
+                cout << "(" << b.at(k)->key << " -> " << b.at(k)->value << ")";
+            }
+            for (Node* node = b.overflow; node; node = node->next) {
+                cout << " -> (" << node->key << " -> " << node->value << ")";
+            }
+            cout << '\n';
         }
+    };
+    show(table.get(), 0, readyBuckets(), "");
+    // непереносённые корзины старой таблицы
+    if (isRehashing()) {
+        show(oldTable.get(), migrated_, capacity_ / 2, "old ");
     }
 }
 
-template<typename Key, typename Value>
-SeparateChainingHashMap<Key, Value>::~SeparateChainingHashMap() {
-    clear();
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::SeparateChainingHashMap(const SeparateChainingHashMap& other)
+    : capacity_(other.capacity_), bits_(other.bits_), size_(other.size_),
+      migrated_(other.migrated_), mode_(other.mode_) {
+    copyBuckets(other.table.get(), other.readyBuckets(), table, capacity_);
+    if (other.isRehashing()) {
+        copyBuckets(other.oldTable.get(), capacity_ / 2, oldTable, capacity_ / 2);
+    }
 }
 
-template<typename Key, typename Value>
-void SeparateChainingHashMap<Key, Value>::clear() {
-    for (Node* node : table) {
-        while (node) {
-            Node* tmp = node;
-            node = node->next;
-            delete tmp;
+// Копия первых count корзин с сохранением порядка пар, остальные пустые
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::copyBuckets(const Bucket* from, size_t count, unique_ptr<Bucket[]>& to, size_t size) {
+    to.reset(new Bucket[size]());
+    for (size_t i = 0; i < count; i++) {
+        for (size_t k = 0; k < from[i].used(); k++) {
+            new (to[i].slots + k * sizeof(Entry)) Entry{*from[i].at(k)};
+        }
+        to[i].tags = from[i].tags;
+
+        Node** last = &to[i].overflow;
+        for (Node* node = from[i].overflow; node; node = node->next) {
+            *last = pool.create(node->key, node->value);
+            last = &((*last)->next);
         }
     }
-    table.assign(capacity_, nullptr);
-    size_ = 0;
 }
 
-template<typename Key, typename Value>
-size_t SeparateChainingHashMap<Key, Value>::hash(const Key& key) const {
-    if constexpr (is_integral_v<Key>) {
-        return (static_cast<size_t>(key) * 37) % capacity_;
-    } else if constexpr (is_same_v<Key, string>) {
-        size_t hash_ = 0;
-        for (char c : key) {
-            hash_ = hash_ * 31 + static_cast<size_t>(c);
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::~SeparateChainingHashMap() {
+    clear(true);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::destroyEntries(Bucket* t, size_t from, size_t to) {
+    if constexpr (!is_trivially_destructible_v<Entry>) {
+        for (size_t i = from; i < to; i++) {
+            Bucket& b = t[i];
+            for (size_t k = 0; k < b.used(); k++) b.at(k)->~Entry();
+            for (Node* node = b.overflow; node; node = node->next) node->~Node();
         }
-        return hash_ % capacity_;
+    }
+}
+
+// Узлы не возвращаются в пул по одному: пул сбрасывается целиком,
+// а корзины обходятся только ради нетривиальных деструкторов
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::clear(bool releaseMemory) {
+    destroyEntries(table.get(), 0, readyBuckets());
+    if (isRehashing()) {
+        destroyEntries(oldTable.get(), migrated_, capacity_ / 2);
+    }
+    if (releaseMemory) {
+        pool.release();
     } else {
-        throw runtime_error ("Unsupported key type for hash");
+        pool.reset();
     }
+    table.reset(new Bucket[capacity_]());
+    oldTable.reset();
+    migrated_ = 0;
+    size_ = 0;
 }
 
-template<typename Key, typename Value>
-void SeparateChainingHashMap<Key, Value>::rehash() {
-    size_t oldCapacity = capacity_;
-    capacity_ = capacity_ * 2 + 1;
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::isRehashing() const {
+    return oldTable != nullptr;
+}
 
-    vector<Node*> newTable(capacity_, nullptr);
+// Сколько первых корзин новой таблицы уже обнулено
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::readyBuckets() const {
+    return isRehashing() ? 2 * migrated_ : capacity_;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::index(size_t h) const {
+    return hashing::fibonacciIndex(h, bits_);
+}
 
-    for (size_t i = 0; i < oldCapacity; i++) {
-        Node* node = table[i];
-        while (node) {
-            Node* nextNode = node->next;
-            size_t idx = hash(node->key) % capacity_;
+// Номер в старой таблице — старшие bits_ - 1 бит того же произведения,
+// то есть index(h) >> 1
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+const typename SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::Bucket&
+SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::bucket(size_t h) const {
+    size_t idx = index(h);
+    if (oldTable && (idx >> 1) >= migrated_) {
+        return oldTable[idx >> 1];
+    }
+    return table[idx];
+}
 
-            node->next = newTable[idx];
-            newTable[idx] = node;
-            node = nextNode;
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+const Value* SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::find(const Key& key, size_t h) const {
+    const Bucket& b = bucket(h);
+    for (uint64_t m = b.match(tagOf(h)); m; m &= m - 1) {
+        const Entry* e = b.at(__builtin_ctzll(m) >> 3);
+        if (KeyEqual{}(e->key, key)) {
+            return &e->value;
         }
     }
+    for (Node* node = b.overflow; node; node = node->next) {
+        if (KeyEqual{}(node->key, key)) {
+            return &node->value;
+        }
+    }
+    return nullptr;
+}
+
+// Новая пара: во встроенную ячейку, если есть место, иначе в начало цепочки
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+template<typename K, typename V>
+void SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::place(Bucket& b, uint8_t tag, K&& key, V&& value) {
+    size_t n = b.used();
+    if (n < INLINE) {
+        new (b.slots + n * sizeof(Entry)) Entry{forward<K>(key), forward<V>(value)};
+        b.setTag(n, tag);
+        return;
+    }
+    Node* node = pool.create(forward<K>(key), forward<V>(value));
+    node->next = b.overflow;
+    b.overflow = node;
+}
+
+// Переносит все пары корзины from в таблицу to и оставляет from пустой
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::moveBucket(Bucket& from, Bucket* to) {
+    for (size_t k = 0; k < from.used(); k++) {
+        Entry* e = from.at(k);
+        size_t h = Hash{}(e->key);
+        place(to[index(h)], tagOf(h), move(e->key), move(e->value));
+        e->~Entry();
+    }
+    from.tags = 0;
+
+    Node* node = from.overflow;
+    while (node) {
+        Node* nextNode = node->next;
+        size_t h = Hash{}(node->key);
+        Bucket& target = to[index(h)];
+        if (target.used() < INLINE) {
+            place(target, tagOf(h), move(node->key), move(node->value));
+            pool.destroy(node);
+        } else {
+            node->next = target.overflow;
+            target.overflow = node;
+        }
+        node = nextNode;
+    }
+    from.overflow = nullptr;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::rehash() {
+    if (mode_ == RehashMode::INCREMENTAL) {
+        while (isRehashing()) migrateStep();
+        oldTable = move(table);
+        capacity_ *= 2;
+        bits_++;
+        table.reset(new Bucket[capacity_]);
+        migrated_ = 0;
+        return;
+    }
+
+    capacity_ *= 2;
+    bits_++;
+
+    unique_ptr<Bucket[]> newTable(new Bucket[capacity_]());
+    for (size_t i = 0; i < capacity_ / 2; i++) {
+        moveBucket(table[i], newTable.get());
+    }
 
     table = move(newTable);
 }
 
-template<typename Key, typename Value>
-void SeparateChainingHashMap<Key, Value>::put(const Key& key, const Value& value) {
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::migrateStep() {
+    size_t oldCapacity = capacity_ / 2;
+    for (size_t step = 0; step < MIGRATE_STEP && migrated_ < oldCapacity; step++, migrated_++) {
+        table[2 * migrated_] = Bucket{};
+        table[2 * migrated_ + 1] = Bucket{};
+        moveBucket(oldTable[migrated_], table.get());
+    }
+
+    if (migrated_ == oldCapacity) {
+        oldTable.reset();
+        migrated_ = 0;
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::put(const Key& key, const Value& value) {
     if (static_cast<double>(size_ + 1) / capacity_ >= LOAD_FACTOR) {
         rehash();
     }
-    
-    size_t idx = hash(key) % capacity_;
-    Node* node = table[idx];
-    while (node) {
-        if (node->key == key) {
-            node->value = value;
-            return;
-        }
+    if (isRehashing()) migrateStep();
 
-        node = node->next;
+    size_t h = Hash{}(key);
+    if (const Value* found = find(key, h)) {
+        *const_cast<Value*>(found) = value;
+        return;
     }
 
-    Node* newNode = new Node(key, value);
-    newNode->next = table[idx];
-    table[idx] = newNode;
+    place(bucket(h), tagOf(h), key, value);
     size_++;
 }
 
-template<typename Key, typename Value>
-void SeparateChainingHashMap<Key, Value>::remove(const Key& key) {
-    size_t idx = hash(key) % capacity_;
-    Node* node = table[idx];
+// Дыра во встроенных ячейках закрывается первым узлом цепочки,
+// а без цепочки — последней встроенной парой
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::remove(const Key& key) {
+    if (isRehashing()) migrateStep();
+
+    size_t h = Hash{}(key);
+    Bucket& b = bucket(h);
+    for (uint64_t m = b.match(tagOf(h)); m; m &= m - 1) {
+        size_t k = __builtin_ctzll(m) >> 3;
+        Entry* hole = b.at(k);
+        if (!KeyEqual{}(hole->key, key)) continue;
+
+        if (b.overflow) {
+            Node* first = b.overflow;
+            b.overflow = first->next;
+            hole->key = move(first->key);
+            hole->value = move(first->value);
+            b.setTag(k, tagOf(Hash{}(hole->key)));
+            pool.destroy(first);
+        } else {
+            size_t lastIdx = b.used() - 1;
+            Entry* last = b.at(lastIdx);
+            if (hole != last) {
+                hole->key = move(last->key);
+                hole->value = move(last->value);
+                b.setTag(k, static_cast<uint8_t>(b.tags >> (8 * lastIdx)));
+            }
+            last->~Entry();
+            b.setTag(lastIdx, 0);
+        }
+        size_--;
+        return;
+    }
+
     Node* prev = nullptr;
-    while (node) {
-        if (node->key == key) {
+    for (Node* node = b.overflow; node; prev = node, node = node->next) {
+        if (KeyEqual{}(node->key, key)) {
             if (prev) {
                 prev->next = node->next;
             } else {
-                table[idx] = node->next;
+                b.overflow = node->next;
             }
-            delete node;
+            pool.destroy(node);
             size_--;
             return;
         }
-        prev = node;
-        node = node->next;
     }
 }
 
-template<typename Key, typename Value>
-vector<pair<Key, Value>> SeparateChainingHashMap<Key, Value>::items() const {
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+vector<pair<Key, Value>> SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::items() const {
     vector<pair<Key, Value>> result;
-    for (size_t i = 0; i < capacity_; i++) {
-        Node* node = table[i];
-        while (node) {
-            result.push_back({node->key, node->value});
-            node = node->next;
-        }
-    }
+    result.reserve(size_);
+    forEachEntry([&](const Key& key, const Value& value) {
+        result.push_back({key, value});
+    });
     return result;
 }
 
-template<typename Key, typename Value>
-Value& SeparateChainingHashMap<Key, Value>::get(const Key& key) {
-    size_t idx = hash(key) % capacity_;
-    
-    Node* node = table[idx];
-    while (node) {
-        if (node->key == key) {
-            return node->value;
-        }
-        node = node->next;
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+Value& SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::get(const Key& key) {
+    // Без шага переноса: иначе второй get мог бы сдвинуть пару, на которую
+    // ссылается результат первого
+    if (const Value* found = find(key, Hash{}(key))) {
+        return *const_cast<Value*>(found);
     }
 
     throw runtime_error("Key not found");
 }
 
-template<typename Key, typename Value>
-const Value& SeparateChainingHashMap<Key, Value>::get(const Key& key) const {
-    size_t idx = hash(key) % capacity_;
-    
-    Node* node = table[idx];
-    while (node) {
-        if (node->key == key) {
-            return node->value;
-        }
-        node = node->next;
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+const Value& SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::get(const Key& key) const {
+    if (const Value* found = find(key, Hash{}(key))) {
+        return *found;
     }
 
     throw runtime_error("Key not found");
 }
 
-template<typename Key, typename Value>
-bool SeparateChainingHashMap<Key, Value>::empty() const {
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::empty() const {
     return true ? size_ == 0 : false;
 }
 
-template<typename Key, typename Value>
-SeparateChainingHashMap<Key, Value>& SeparateChainingHashMap<Key, Value>::operator=(const SeparateChainingHashMap& other) {
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::size() const {
+    return size_;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+SeparateChainingHashMap<Key, Value, Hash, KeyEqual>& SeparateChainingHashMap<Key, Value, Hash, KeyEqual>::operator=(const SeparateChainingHashMap& other) {
     if (this == &other) {
         return *this;
     }
     clear();
     capacity_ = other.capacity_;
+    bits_ = other.bits_;
     size_ = other.size_;
-    table.assign(capacity_, nullptr);
-
-    for (size_t i = 0; i < capacity_; i++) {
-        Node* node = other.table[i];
-        Node** last = &table[i];
-        while (node) {
-            *last = new Node(node->key, node->value);
-            last = &((*last)->next);
-            node = node->next;
-        }
+    migrated_ = other.migrated_;
+    mode_ = other.mode_;
+    copyBuckets(other.table.get(), other.readyBuckets(), table, capacity_);
+    if (other.isRehashing()) {
+        copyBuckets(other.oldTable.get(), capacity_ / 2, oldTable, capacity_ / 2);
     }
     return *this;
 }
@@ -0,0 +1,240 @@
+#pragma once
+#include <climits>
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "HashFunctions.hpp"
+#include "SeparateChainingHashTable.hpp"
+#include "../../json.hpp"
+
+using namespace std;
+
+// Ключи делятся между независимыми таблицами Inner (шардами) по старшим
+// битам хэша, у каждого шарда свой мьютекс. Потоки, попавшие в разные
+// шарды, не ждут друг друга и не делят строки кэша: шард выровнен по
+// строке кэша и выделен отдельно.
+// Inner — словарь с конструктором от ёмкости и методами put, remove,
+// contains, get, size, clear и items. Внутренние таблицы берут номер
+// корзины из старших бит h * φ (fibonacciIndex), а не из старших бит h,
+// поэтому внутри шарда ключи раскладываются по всей таблице
+template<typename Key, typename Value, typename Inner = SeparateChainingHashMap<Key, Value>, typename Hash = FastHash<Key>>
+class ShardedHashMap {
+private:
+    struct alignas(64) Shard {
+        mutable mutex lock;
+        Inner map;
+        Shard() = default;
+        explicit Shard(size_t capacity) : map(capacity) {}
+    };
+
+    static constexpr size_t DEFAULT_SHARDS = 64;
+    static constexpr size_t MAX_SHARDS = 1 << 16;
+
+    vector<unique_ptr<Shard>> shards;
+    unsigned shift;  // номер шарда — старшие log2(shards.size()) бит хэша
+
+    size_t shardOf(const Key& key) const {
+        return Hash{}(key) >> shift;
+    }
+
+    // f(i) для всех шардов, шарды делятся между потоками по остатку.
+    // Блокировку шарда берёт сам f
+    template<typename F>
+    void forEachShardParallel(F f) const {
+        size_t workers = min<size_t>(shards.size(), max(1u, thread::hardware_concurrency()));
+        if (workers == 1) {
+            for (size_t i = 0; i < shards.size(); i++) f(i);
+            return;
+        }
+
+        vector<exception_ptr> errors(workers);
+        vector<thread> pool;
+        for (size_t t = 0; t < workers; t++) {
+            pool.emplace_back([&, t]() {
+                try {
+                    for (size_t i = t; i < shards.size(); i += workers) f(i);
+                } catch (...) {
+                    errors[t] = current_exception();
+                }
+            });
+        }
+        for (auto& th : pool) th.join();
+        for (auto& e : errors) {
+            if (e) rethrow_exception(e);
+        }
+    }
+
+    // Пары раскладываются по шардам, шарды заполняются параллельно
+    void putAll(const vector<pair<Key, Value>>& pairs) {
+        vector<vector<size_t>> byShard(shards.size());
+        for (size_t i = 0; i < pairs.size(); i++) byShard[shardOf(pairs[i].first)].push_back(i);
+
+        forEachShardParallel([&](size_t s) {
+            lock_guard<mutex> guard(shards[s]->lock);
+            for (size_t i : byShard[s]) shards[s]->map.put(pairs[i].first, pairs[i].second);
+        });
+    }
+
+public:
+    // Признак для бенчмарка потоков: внешний мьютекс не нужен
+    static constexpr bool concurrent = true;
+
+    // capacity — ожидаемое число ключей всего, 0 — ёмкость Inner по умолчанию
+    ShardedHashMap(size_t capacity = 0, size_t shardCount = DEFAULT_SHARDS) {
+        size_t count = hashing::roundUpPow2(min(shardCount, MAX_SHARDS));
+        shift = static_cast<unsigned>(sizeof(size_t) * CHAR_BIT) - hashing::log2Pow2(count);
+        shards.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            shards.push_back(capacity ? make_unique<Shard>(capacity / count + 1) : make_unique<Shard>());
+        }
+    }
+
+    ShardedHashMap(const ShardedHashMap&) = delete;
+    ShardedHashMap& operator=(const ShardedHashMap&) = delete;
+
+    void put(const Key& key, const Value& value) {
+        Shard& s = *shards[shardOf(key)];
+        lock_guard<mutex> guard(s.lock);
+        s.map.put(key, value);
+    }
+
+    bool remove(const Key& key) {
+        Shard& s = *shards[shardOf(key)];
+        lock_guard<mutex> guard(s.lock);
+        if constexpr (is_same_v<decltype(s.map.remove(key)), bool>) {
+            return s.map.remove(key);
+        } else {
+            if (!s.map.contains(key)) return false;
+            s.map.remove(key);
+            return true;
+        }
+    }
+
+    bool contains(const Key& key) const {
+        const Shard& s = *shards[shardOf(key)];
+        lock_guard<mutex> guard(s.lock);
+        return s.map.contains(key);
+    }
+
+    // Копия значения: ссылка в таблицу пережила бы блокировку шарда
+    Value get(const Key& key) const {
+        const Shard& s = *shards[shardOf(key)];
+        lock_guard<mutex> guard(s.lock);
+        return s.map.get(key);
+    }
+
+    // size, items и сериализация берут шарды по очереди: при параллельных
+    // изменениях это не снимок всей таблицы на один момент
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& s : shards) {
+            lock_guard<mutex> guard(s->lock);
+            total += s->map.size();
+        }
+        return total;
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t shardCount() const { return shards.size(); }
+
+    size_t shardSize(size_t i) const {
+        lock_guard<mutex> guard(shards[i]->lock);
+        return shards[i]->map.size();
+    }
+
+    void clear() {
+        forEachShardParallel([&](size_t s) {
+            lock_guard<mutex> guard(shards[s]->lock);
+            shards[s]->map.clear();
+        });
+    }
+
+    vector<pair<Key, Value>> items() const {
+        vector<vector<pair<Key, Value>>> parts(shards.size());
+        forEachShardParallel([&](size_t s) {
+            lock_guard<mutex> guard(shards[s]->lock);
+            parts[s] = shards[s]->map.items();
+        });
+
+        size_t total = 0;
+        for (const auto& part : parts) total += part.size();
+        vector<pair<Key, Value>> result;
+        result.reserve(total);
+        for (auto& part : parts) {
+            move(part.begin(), part.end(), back_inserter(result));
+        }
+        return result;
+    }
+
+    void display() const {
+        for (const auto& [key, value] : items()) {
+            cout << key << " : " << value << endl;
+        }
+    }
+
+    void to_json(nlohmann::json& j) const {
+        // массивы шардов собираются параллельно и склеиваются по порядку
+        vector<nlohmann::json> parts(shards.size());
+        forEachShardParallel([&](size_t s) {
+            nlohmann::json part = nlohmann::json::array();
+            lock_guard<mutex> guard(shards[s]->lock);
+            for (const auto& [key, value] : shards[s]->map.items()) {
+                part.push_back({{"key", key}, {"value", value}});
+            }
+            parts[s] = move(part);
+        });
+
+        j = nlohmann::json{{"items", nlohmann::json::array()}, {"shards", shards.size()}};
+        for (auto& part : parts) {
+            for (auto& item : part) j["items"].push_back(move(item));
+        }
+    }
+
+    void from_json(const nlohmann::json& j) {
+        clear();
+        const auto& arr = j.at("items");
+        vector<pair<Key, Value>> pairs;
+        pairs.reserve(arr.size());
+        for (const auto& item : arr) {
+            pairs.push_back({item.at("key").get<Key>(), item.at("value").get<Value>()});
+        }
+        putAll(pairs);
+    }
+
+    void to_binary(ostream& out) const {
+        // число шардов, число пар, затем key, value
+        vector<pair<Key, Value>> all = items();
+        size_t count = shards.size(), total = all.size();
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        out.write(reinterpret_cast<const char*>(&total), sizeof(total));
+        for (const auto& [key, value] : all) {
+            out.write(reinterpret_cast<const char*>(&key), sizeof(Key));
+            out.write(reinterpret_cast<const char*>(&value), sizeof(Value));
+        }
+    }
+
+    void from_binary(istream& in) {
+        clear();
+        size_t count = 0, total = 0;
+        in.read(reinterpret_cast<char*>(&count), sizeof(count));
+        in.read(reinterpret_cast<char*>(&total), sizeof(total));
+        vector<pair<Key, Value>> pairs;
+        for (size_t i = 0; i < total; ++i) {
+            Key key;
+            Value value;
+            in.read(reinterpret_cast<char*>(&key), sizeof(Key));
+            in.read(reinterpret_cast<char*>(&value), sizeof(Value));
+            if (!in) break;
+            pairs.push_back({key, value});
+        }
+        putAll(pairs);
+    }
+};
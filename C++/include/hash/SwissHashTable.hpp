@@ -0,0 +1,333 @@
+#pragma once
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "HashFunctions.hpp"
+#include "../../json.hpp"
+
+using namespace std;
+
+// Открытая адресация в стиле Swiss table: рядом с массивом ячеек лежит
+// массив однобайтовых меток. Метка занятой ячейки — младшие 7 бит хэша,
+// у пустой и удалённой установлен старший бит. Поиск сравнивает сразу
+// группу из 16 меток (SSE2) и читает только ячейки с совпавшей меткой
+template<typename Key, typename Value, typename Hash = FastHash<Key>, typename KeyEqual = equal_to<Key>>
+class SwissHashMap {
+private:
+    struct Slot {
+        Key key;
+        Value value;
+    };
+
+    static constexpr size_t GROUP = 16;
+    static constexpr int8_t EMPTY = -128;
+    static constexpr int8_t DELETED = -2;
+
+    int8_t* ctrl;
+    Slot* slots;
+    size_t capacity;  // степень двойки, кратная GROUP
+    size_t count;
+    size_t deleted;
+
+    // Битовые маски по 16 меткам группы, начинающейся с g
+    static uint32_t matchTag(const int8_t* g, int8_t tag);
+    static uint32_t matchEmpty(const int8_t* g);
+    static uint32_t matchFree(const int8_t* g);
+
+    static size_t hashCode(const Key& key);
+    static size_t roundCapacity(size_t cap);
+    size_t findIndex(const Key& key) const;
+    size_t findFree(size_t h) const;
+    void insertNew(size_t h, const Key& key, const Value& value);
+    void allocate(size_t cap);
+    void rehash(size_t newCapacity);
+
+public:
+    SwissHashMap(size_t cap = 16);
+    ~SwissHashMap();
+    SwissHashMap(const SwissHashMap&) = delete;
+    SwissHashMap& operator=(const SwissHashMap&) = delete;
+
+    void put(const Key& key, const Value& value);
+    bool remove(const Key& key);
+    bool contains(const Key& key) const;
+    Value get(const Key& key) const;
+
+    size_t size() const;
+    bool isEmpty() const;
+    size_t getCapacity() const;
+    void display() const;
+    void clear();
+
+    void to_json(nlohmann::json& j) const {
+        j = nlohmann::json{{"items", nlohmann::json::array()}, {"capacity", capacity}};
+        for (size_t i = 0; i < capacity; ++i) {
+            if (ctrl[i] >= 0) {
+                j["items"].push_back({{"key", slots[i].key}, {"value", slots[i].value}});
+            }
+        }
+    }
+
+    void from_json(const nlohmann::json& j) {
+        delete[] ctrl;
+        delete[] slots;
+        allocate(j.at("capacity").get<size_t>());
+        auto arr = j.at("items");
+        for (size_t i = 0; i < arr.size(); ++i) {
+            put(arr[i]["key"].get<Key>(), arr[i]["value"].get<Value>());
+        }
+    }
+
+    void to_binary(ostream& out) const {
+        // capacity, count, затем занятые ячейки с маркером 1
+        out.write(reinterpret_cast<const char*>(&capacity), sizeof(capacity));
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        for (size_t i = 0; i < capacity; ++i) {
+            if (ctrl[i] >= 0) {
+                const char marker = 1;
+                out.write(&marker, 1);
+                out.write(reinterpret_cast<const char*>(&slots[i].key), sizeof(Key));
+                out.write(reinterpret_cast<const char*>(&slots[i].value), sizeof(Value));
+            }
+        }
+        const char end_marker = 0;
+        out.write(&end_marker, 1);
+    }
+
+    void from_binary(istream& in) {
+        delete[] ctrl;
+        delete[] slots;
+        size_t cap = 0, expected = 0;
+        in.read(reinterpret_cast<char*>(&cap), sizeof(cap));
+        in.read(reinterpret_cast<char*>(&expected), sizeof(expected));
+        allocate(cap);
+        size_t loaded = 0;
+        while (loaded < expected) {
+            char marker = 0;
+            in.read(&marker, 1);
+            if (!in || marker == 0) break;
+            Key k;
+            Value v;
+            in.read(reinterpret_cast<char*>(&k), sizeof(Key));
+            in.read(reinterpret_cast<char*>(&v), sizeof(Value));
+            put(k, v);
+            ++loaded;
+        }
+    }
+};
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+uint32_t SwissHashMap<Key, Value, Hash, KeyEqual>::matchTag(const int8_t* g, int8_t tag) {
+#if defined(__SSE2__)
+    __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(g));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(tag))));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < GROUP; i++) {
+        if (g[i] == tag) mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+uint32_t SwissHashMap<Key, Value, Hash, KeyEqual>::matchEmpty(const int8_t* g) {
+    return matchTag(g, EMPTY);
+}
+
+// Пустые и удалённые: у обеих меток установлен старший бит
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+uint32_t SwissHashMap<Key, Value, Hash, KeyEqual>::matchFree(const int8_t* g) {
+#if defined(__SSE2__)
+    __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(g));
+    return static_cast<uint32_t>(_mm_movemask_epi8(group));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < GROUP; i++) {
+        if (g[i] < 0) mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+// Метка берётся из младших 7 бит, номер группы — из старших, поэтому
+// Hash должен перемешивать все биты (как FastHash), а не быть тождественным
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t SwissHashMap<Key, Value, Hash, KeyEqual>::hashCode(const Key& key) {
+    return Hash{}(key);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t SwissHashMap<Key, Value, Hash, KeyEqual>::roundCapacity(size_t cap) {
+    size_t result = GROUP;
+    while (result < cap) result *= 2;
+    return result;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void SwissHashMap<Key, Value, Hash, KeyEqual>::allocate(size_t cap) {
+    capacity = roundCapacity(cap);
+    ctrl = new int8_t[capacity];
+    memset(ctrl, EMPTY, capacity);
+    slots = new Slot[capacity];
+    count = 0;
+    deleted = 0;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+SwissHashMap<Key, Value, Hash, KeyEqual>::SwissHashMap(size_t cap) {
+    allocate(cap);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+SwissHashMap<Key, Value, Hash, KeyEqual>::~SwissHashMap() {
+    delete[] ctrl;
+    delete[] slots;
+}
+
+// Группы перебираются с шагом 1, 2, 3, ...: при числе групп, равном
+// степени двойки, так обходится каждая группа ровно один раз
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t SwissHashMap<Key, Value, Hash, KeyEqual>::findIndex(const Key& key) const {
+    size_t h = hashCode(key);
+    int8_t tag = static_cast<int8_t>(h & 0x7F);
+    size_t groupMask = capacity / GROUP - 1;
+    size_t g = (h >> 7) & groupMask;
+
+    for (size_t step = 1; step <= groupMask + 1; step++) {
+        const int8_t* group = ctrl + g * GROUP;
+        for (uint32_t bits = matchTag(group, tag); bits; bits &= bits - 1) {
+            size_t idx = g * GROUP + __builtin_ctz(bits);
+            if (KeyEqual{}(slots[idx].key, key)) return idx;
+        }
+        if (matchEmpty(group)) return capacity;
+        g = (g + step) & groupMask;
+    }
+
+    return capacity;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t SwissHashMap<Key, Value, Hash, KeyEqual>::findFree(size_t h) const {
+    size_t groupMask = capacity / GROUP - 1;
+    size_t g = (h >> 7) & groupMask;
+
+    for (size_t step = 1; step <= groupMask + 1; step++) {
+        uint32_t bits = matchFree(ctrl + g * GROUP);
+        if (bits) return g * GROUP + __builtin_ctz(bits);
+        g = (g + step) & groupMask;
+    }
+
+    throw runtime_error("Hash table is full");
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void SwissHashMap<Key, Value, Hash, KeyEqual>::insertNew(size_t h, const Key& key, const Value& value) {
+    size_t idx = findFree(h);
+    if (ctrl[idx] == DELETED) deleted--;
+    ctrl[idx] = static_cast<int8_t>(h & 0x7F);
+    slots[idx].key = key;
+    slots[idx].value = value;
+    count++;
+}
+
+// Переносит занятые ячейки в новую таблицу; DELETED при этом исчезают
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void SwissHashMap<Key, Value, Hash, KeyEqual>::rehash(size_t newCapacity) {
+    int8_t* oldCtrl = ctrl;
+    Slot* oldSlots = slots;
+    size_t oldCapacity = capacity;
+
+    allocate(newCapacity);
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (oldCtrl[i] >= 0) {
+            insertNew(hashCode(oldSlots[i].key), oldSlots[i].key, oldSlots[i].value);
+        }
+    }
+
+    delete[] oldCtrl;
+    delete[] oldSlots;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void SwissHashMap<Key, Value, Hash, KeyEqual>::put(const Key& key, const Value& value) {
+    size_t idx = findIndex(key);
+    if (idx != capacity) {
+        slots[idx].value = value;
+        return;
+    }
+
+    // заполнение не выше 7/8 с учётом DELETED; если место заняли
+    // в основном DELETED, хватит пересборки без роста
+    if ((count + deleted + 1) * 8 > capacity * 7) {
+        rehash((count + 1) * 16 > capacity * 7 ? capacity * 2 : capacity);
+    }
+    insertNew(hashCode(key), key, value);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+Value SwissHashMap<Key, Value, Hash, KeyEqual>::get(const Key& key) const {
+    size_t idx = findIndex(key);
+    if (idx == capacity) throw runtime_error("Key not found");
+    return slots[idx].value;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool SwissHashMap<Key, Value, Hash, KeyEqual>::contains(const Key& key) const {
+    return findIndex(key) != capacity;
+}
+
+// Если в группе есть пустая метка, поиск на ней и так остановится,
+// поэтому ячейку можно сразу сделать пустой; иначе нужен DELETED
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool SwissHashMap<Key, Value, Hash, KeyEqual>::remove(const Key& key) {
+    size_t idx = findIndex(key);
+    if (idx == capacity) return false;
+
+    if (matchEmpty(ctrl + idx / GROUP * GROUP)) {
+        ctrl[idx] = EMPTY;
+    } else {
+        ctrl[idx] = DELETED;
+        deleted++;
+    }
+    count--;
+    return true;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t SwissHashMap<Key, Value, Hash, KeyEqual>::size() const {
+    return count;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+bool SwissHashMap<Key, Value, Hash, KeyEqual>::isEmpty() const {
+    return count == 0;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t SwissHashMap<Key, Value, Hash, KeyEqual>::getCapacity() const {
+    return capacity;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void SwissHashMap<Key, Value, Hash, KeyEqual>::clear() {
+    memset(ctrl, EMPTY, capacity);
+    count = 0;
+    deleted = 0;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void SwissHashMap<Key, Value, Hash, KeyEqual>::display() const {
+    for (size_t i = 0; i < capacity; i++) {
+        if (ctrl[i] >= 0) {
+            cout << slots[i].key << " : " << slots[i].value << endl;
+        }
+    }
+}
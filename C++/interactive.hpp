@@ -2,6 +2,7 @@
 #include <string>
 #include <fstream>
 #include <limits>
+#include <stdexcept>
 
 #include "json.hpp"
 
@@ -42,8 +43,13 @@ void runInteractive(const string& name) {
                 cin.ignore(numeric_limits<streamsize>::max(), '\n');
                 continue;
             }
-            ds.push_back(x);
-            cout << "< OK\n";
+            try {
+                ds.push_back(x);
+                cout << "< OK\n";
+            } catch (const overflow_error& e) {
+                // множества фиксированной ёмкости (lockfreehash)
+                cout << "< " << e.what() << "\n";
+            }
         }
         else if (cmd == "remove") {
             int x;
@@ -3,6 +3,9 @@
 #include <cstdlib>
 #include <chrono>
 #include <fstream>
+#include <map>
+#include <cmath>
+#include <climits>
 
 #include "Array.hpp"
 #include "LinkedList.hpp"
@@ -13,8 +16,19 @@
 #include "SeparateChainingHashTable.hpp"
 #include "DoubleHashingHashTable.hpp"
 #include "LinearProbingHashTable.hpp"
+#include "RobinHoodHashTable.hpp"
+#include "SwissHashTable.hpp"
+#include "CuckooHashTable.hpp"
+#include "ConcurrentSeparateChainingHashTable.hpp"
+#include "ShardedHashTable.hpp"
+#include "LockFreeHashTable.hpp"
+#include "stdbaseline.hpp"
 
+#include "alloctrack.hpp"
 #include "benchmark.hpp"
+#include "workload.hpp"
+#include "report.hpp"
+#include "threadbench.hpp"
 #include "interactive.hpp"
 #include "json.hpp"
 
@@ -29,8 +43,68 @@ void help() {
     cout << "  ./main benchmark avltree insert 100000\n";
     cout << "  ./main benchmark avltree remove\n";
     cout << "  ./main benchmark avltree find\n";
+    cout << "Опции:\n";
+    cout << "  --warmup=N   прогревочные запуски (по умолчанию 1)\n";
+    cout << "  --repeats=N  замеры для статистики (по умолчанию 5)\n";
+    cout << "  --latency    гистограмма задержек каждой операции (p50/p99/p999/max)\n";
+    cout << "  --perf       аппаратные счётчики (Linux perf_event_open) на операцию\n";
+    cout << "  --format=F   формат вывода: text (по умолчанию), json, csv\n";
+    cout << "  --dist=D     распределение ключей: uniform (по умолчанию), sequential, strided,\n";
+    cout << "               zipf, clustered, adversarial\n";
+    cout << "  --seed=S     зерно генератора (по умолчанию 42)\n";
+    cout << "  --stride=K   шаг для strided (по умолчанию 16)\n";
+    cout << "  --theta=T    параметр zipf (по умолчанию 0.99); ключи zipf повторяются, разных меньше n\n";
+    cout << "  --cluster=C  длина диапазона для clustered (по умолчанию 64)\n";
+    cout << "  --modulus=M  ключи кратны M для adversarial (по умолчанию n)\n";
+    cout << "  ./main benchmark avltree find 50000 --repeats=20\n";
+    cout << "  ./main benchmark separatechaininghash-incremental insert 1000000 --latency\n";
+    cout << "  (сравните с separatechaininghash: корзины переносятся постепенно, максимум задержки\n";
+    cout << "   вставки ниже, но p99 и среднее время выше)\n";
+    cout << "Пакетный поиск (action = findbatch): contains_batch пакетами по 256 ключей против поштучного contains\n";
+    cout << "  (doublehash, linearprobinghash, separatechaininghash)\n";
+    cout << "  ./main benchmark linearprobinghash findbatch 1000000\n";
+    cout << "Смешанная нагрузка (action = mixed), выводит пропускную способность и задержки:\n";
+    cout << "  --ratio=R:I:D  доли чтений, вставок и удалений (по умолчанию 50:45:5)\n";
+    cout << "  --ops=N        число операций (по умолчанию равно количеству элементов)\n";
+    cout << "  ./main benchmark linearprobinghash mixed 100000 --ratio=40:30:30 --ops=1000000\n";
+    cout << "Масштабирование по потокам (количество элементов — операций на поток):\n";
+    cout << "  --threads=N    замер для 1, 2, 4, ..., N потоков: своя структура в каждом потоке\n";
+    cout << "                 и одна общая под мьютексом; --independent — только первый вариант\n";
+    cout << "  ./main benchmark separatechaininghash find 100000 --threads=8\n";
+    cout << "  separatechaininghash-concurrent — общая таблица без мьютекса: блокировки на полосы корзин\n";
+    cout << "  ./main benchmark separatechaininghash-concurrent mixed 100000 --threads=8 --ratio=80:15:5\n";
+    cout << "  shardedhash, shardedhash-linearprobing — 64 независимых таблицы с мьютексом на каждую\n";
+    cout << "  ./main benchmark shardedhash mixed 100000 --threads=32\n";
+    cout << "  lockfreehash — множество фиксированной ёмкости без блокировок (CAS), contains только читает\n";
+    cout << "  ./main benchmark lockfreehash find 100000 --threads=8\n";
 
-    cout << "  \n2. Работа со структурами: ./main interactive <structure>\n";
+    cout << "  \n2. Зависимость от размера (CSV): ./main sweep <structure> <action> [--from=1000] [--to=100000000] [--factor=2]\n";
+    cout << "  Размеры: from, from*factor, ... до to; принимает те же опции, что и benchmark\n";
+    cout << "Примеры:\n";
+    cout << "  ./main sweep separatechaininghash find --to=10000000 > sweep.csv\n";
+
+    cout << "  \n3. Сравнение со стандартной библиотекой: ./main baseline <action> [количество элементов]\n";
+    cout << "  Пары: array/std-vector, linkedlist/std-list, queue/std-deque, avltree/std-set,\n";
+    cout << "  doublehash, cuckoohash/std-unordered-set, linearprobinghash, robinhoodhash, swisshash,\n";
+    cout << "  cuckoohashmap и separatechaininghash/std-unordered-map.\n";
+    cout << "  Память на элемент выводится в сборке make bench. Структуры std-* доступны и в benchmark/sweep\n";
+    cout << "Примеры:\n";
+    cout << "  ./main baseline find 100000 --format=csv\n";
+
+    cout << "  \n4. Сравнение с базовым результатом: ./main compare <baseline.json> <current.json> [--threshold=10]\n";
+    cout << "  Код возврата 2, если медиана серии выросла больше чем на threshold процентов\n";
+    cout << "Примеры:\n";
+    cout << "  ./main benchmark avltree find --format=json > baseline.json\n";
+    cout << "  ./main compare baseline.json current.json --threshold=5\n";
+
+    cout << "  \n5. Устойчивое обновление: ./main churn <structure> [количество элементов] [--cycles=1000000] [--points=10]\n";
+    cout << "  Размер не меняется: каждый цикл вставляет новый ключ и удаляет самый старый.\n";
+    cout << "  После каждой части циклов выводит время contains для присутствующих и отсутствующих ключей.\n";
+    cout << "  linearprobinghash-tombstone — та же таблица с удалением через DELETED. Принимает --format=csv\n";
+    cout << "Примеры:\n";
+    cout << "  ./main churn linearprobinghash 100000 --cycles=5000000\n";
+
+    cout << "  \n6. Работа со структурами: ./main interactive <structure>\n";
     cout << "Примеры:\n";
     cout << "  ./main interactive avltree\n";
     cout << "  > add 394\n";
@@ -43,127 +117,648 @@ void help() {
     cout << "  > exit\n";
 }
 
+BenchConfig parseBenchConfig(map<string, string>& options) {
+    BenchConfig cfg;
+    if (options.count("warmup")) cfg.warmup = stoi(options["warmup"]);
+    if (options.count("repeats")) cfg.repeats = stoi(options["repeats"]);
+    cfg.latency = options.count("latency") > 0;
+    cfg.perf = options.count("perf") > 0;
+    if (cfg.warmup < 0 || cfg.repeats < 1) {
+        throw invalid_argument("Некорректное число запусков");
+    }
+    return cfg;
+}
+
+WorkloadConfig parseWorkload(map<string, string>& options) {
+    WorkloadConfig workload;
+    if (options.count("dist")) workload.distribution = options["dist"];
+    if (options.count("seed")) workload.seed = stoul(options["seed"]);
+    if (options.count("stride")) workload.stride = stoi(options["stride"]);
+    if (options.count("modulus")) workload.modulus = stoll(options["modulus"]);
+    if (options.count("theta")) workload.theta = stod(options["theta"]);
+    if (options.count("cluster")) workload.clusterSize = stoi(options["cluster"]);
+    return workload;
+}
+
+// Прогон insert/find/remove для выбранной структуры; false — структура неизвестна
+bool runBenchmark(const string& structure, const string& operation, vector<int>& data, int n,
+                  const BenchConfig& cfg, BenchResult& result) {
+    if (structure == "array") {
+        runDSBenchmark<Array<int>>(operation, data, n, cfg, result);
+    }
+    else if (structure == "linkedlist") {
+        runDSBenchmark<LinkedList<int>>(operation, data, n, cfg, result);
+    }
+    else if (structure == "forwardlist") {
+        runDSBenchmark<ForwardList<int>>(operation, data, n, cfg, result);
+    }
+    else if (structure == "queue") {
+        runDSBenchmark<Queue<int>>(operation, data, n, cfg, result);
+    }
+    else if (structure == "stack") {
+        runDSBenchmark<Stack<int>>(operation, data, n, cfg, result);
+    }
+    else if (structure == "avltree") {
+        runHashBenchmark<AVLTree<int>>(operation, data, n, cfg, result);
+    }
+    else if (structure == "doublehash") {
+        runHashBenchmark<DoubleHashingSet<int>>(operation, data, n, cfg, result);
+    }
+    else if (structure == "cuckoohash") {
+        runHashBenchmark<CuckooHashSet<int>>(operation, data, n, cfg, result);
+    }
+    else if (structure == "lockfreehash") {
+        runSetBenchmark(operation, data, n,
+                        [&]() { return make_unique<LockFreeHashSet<int>>(n); }, cfg, result);
+    }
+    else if (structure == "cuckoohashmap") {
+        runMapBenchmark(operation, data, n,
+                        [&]() { return make_unique<CuckooHashMap<int, int>>(n); }, cfg, result);
+    }
+    else if (structure == "linearprobinghash") {
+        runMapBenchmark(operation, data, n,
+                        [&]() { return make_unique<LinearProbingHashMap<int, int>>(n); }, cfg, result);
+    }
+    else if (structure == "linearprobinghash-tombstone") {
+        runMapBenchmark(operation, data, n,
+                        [&]() { return make_unique<LinearProbingHashMap<int, int>>(n, DeletionMode::TOMBSTONE); }, cfg, result);
+    }
+    else if (structure == "robinhoodhash") {
+        runMapBenchmark(operation, data, n,
+                        [&]() { return make_unique<RobinHoodHashMap<int, int>>(n); }, cfg, result);
+    }
+    else if (structure == "swisshash") {
+        runMapBenchmark(operation, data, n,
+                        [&]() { return make_unique<SwissHashMap<int, int>>(n); }, cfg, result);
+    }
+    else if (structure == "separatechaininghash") {
+        runMapBenchmark(operation, data, n,
+                        []() { return make_unique<SeparateChainingHashMap<int, int>>(); }, cfg, result);
+    }
+    else if (structure == "separatechaininghash-incremental") {
+        runMapBenchmark(operation, data, n,
+                        [&]() { return make_unique<SeparateChainingHashMap<int, int>>(11, RehashMode::INCREMENTAL); }, cfg, result);
+    }
+    else if (structure == "separatechaininghash-concurrent") {
+        runMapBenchmark(operation, data, n,
+                        []() { return make_unique<ConcurrentSeparateChainingHashMap<int, int>>(); }, cfg, result);
+    }
+    else if (structure == "shardedhash") {
+        runMapBenchmark(operation, data, n,
+                        [&]() { return make_unique<ShardedHashMap<int, int>>(n); }, cfg, result);
+    }
+    else if (structure == "shardedhash-linearprobing") {
+        runMapBenchmark(operation, data, n,
+                        [&]() { return make_unique<ShardedHashMap<int, int, LinearProbingHashMap<int, int>>>(n); }, cfg, result);
+    }
+    else if (structure == "std-vector") {
+        runDSBenchmark<StdVector<int>>(operation, data, n, cfg, result);
+    }
+    else if (structure == "std-list") {
+        runDSBenchmark<StdList<int>>(operation, data, n, cfg, result);
+    }
+    else if (structure == "std-deque") {
+        runDSBenchmark<StdDeque<int>>(operation, data, n, cfg, result);
+    }
+    else if (structure == "std-set") {
+        runHashBenchmark<StdSet<int>>(operation, data, n, cfg, result);
+    }
+    else if (structure == "std-unordered-set") {
+        runHashBenchmark<StdUnorderedSet<int>>(operation, data, n, cfg, result);
+    }
+    else if (structure == "std-unordered-map") {
+        runMapBenchmark(operation, data, n,
+                        []() { return make_unique<StdUnorderedMap<int, int>>(); }, cfg, result);
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+// CSV: время на операцию для геометрического ряда размеров
+int runSweep(const string& structure, const string& operation, map<string, string>& options) {
+    BenchConfig cfg = parseBenchConfig(options);
+    WorkloadConfig workload = parseWorkload(options);
+    long long from = options.count("from") ? stoll(options["from"]) : 1000;
+    long long to = options.count("to") ? stoll(options["to"]) : 100000000;
+    double factor = options.count("factor") ? stod(options["factor"]) : 2.0;
+    if (from < 1 || to < from || to > INT_MAX / 10 || factor <= 1.0) {
+        throw invalid_argument("Некорректный диапазон размеров");
+    }
+
+    vector<int> sizes;
+    for (double size = from; size < to; size *= factor) {
+        int n = static_cast<int>(llround(size));
+        if (sizes.empty() || n != sizes.back()) sizes.push_back(n);
+    }
+    if (sizes.empty() || sizes.back() != to) sizes.push_back(static_cast<int>(to));
+
+    cout << "structure,operation,distribution,n,ns_per_op_min,ns_per_op_median,ns_per_op_p90,series_median_ns\n";
+    for (int n : sizes) {
+        vector<int> data = generateData(workload, n);
+        BenchResult result;
+        if (!runBenchmark(structure, operation, data, n, cfg, result)) {
+            cerr << "Неизвестная структура: " << structure << "\n";
+            return 1;
+        }
+
+        const BenchStats& s = result.series;
+        cout << structure << ',' << operation << ',' << workload.distribution << ',' << n << ','
+             << (double)s.min / n << ',' << (double)s.median / n << ',' << (double)s.p90 / n << ','
+             << s.median << endl;
+    }
+    return 0;
+}
+
+// Создаёт выбранную структуру и передаёт её в f.
+// capacity — начальная ёмкость для таблиц, которые не растут сами
+template<typename F>
+bool withStructure(const string& structure, size_t capacity, F f) {
+    if (structure == "array") {
+        Array<int> ds;
+        f(ds);
+    }
+    else if (structure == "linkedlist") {
+        LinkedList<int> ds;
+        f(ds);
+    }
+    else if (structure == "forwardlist") {
+        ForwardList<int> ds;
+        f(ds);
+    }
+    else if (structure == "queue") {
+        Queue<int> ds;
+        f(ds);
+    }
+    else if (structure == "stack") {
+        Stack<int> ds;
+        f(ds);
+    }
+    else if (structure == "avltree") {
+        AVLTree<int> ds;
+        f(ds);
+    }
+    else if (structure == "doublehash") {
+        DoubleHashingSet<int> ds;
+        f(ds);
+    }
+    else if (structure == "cuckoohash") {
+        CuckooHashSet<int> ds;
+        f(ds);
+    }
+    else if (structure == "lockfreehash") {
+        LockFreeHashSet<int> ds(capacity);
+        f(ds);
+    }
+    else if (structure == "cuckoohashmap") {
+        CuckooHashMap<int, int> ds(capacity);
+        f(ds);
+    }
+    else if (structure == "linearprobinghash") {
+        LinearProbingHashMap<int, int> ds(capacity);
+        f(ds);
+    }
+    else if (structure == "linearprobinghash-tombstone") {
+        LinearProbingHashMap<int, int> ds(capacity, DeletionMode::TOMBSTONE);
+        f(ds);
+    }
+    else if (structure == "robinhoodhash") {
+        RobinHoodHashMap<int, int> ds(capacity);
+        f(ds);
+    }
+    else if (structure == "swisshash") {
+        SwissHashMap<int, int> ds(capacity);
+        f(ds);
+    }
+    else if (structure == "separatechaininghash") {
+        SeparateChainingHashMap<int, int> ds;
+        f(ds);
+    }
+    else if (structure == "separatechaininghash-incremental") {
+        SeparateChainingHashMap<int, int> ds(11, RehashMode::INCREMENTAL);
+        f(ds);
+    }
+    else if (structure == "separatechaininghash-concurrent") {
+        ConcurrentSeparateChainingHashMap<int, int> ds;
+        f(ds);
+    }
+    else if (structure == "shardedhash") {
+        ShardedHashMap<int, int> ds(capacity);
+        f(ds);
+    }
+    else if (structure == "shardedhash-linearprobing") {
+        ShardedHashMap<int, int, LinearProbingHashMap<int, int>> ds(capacity);
+        f(ds);
+    }
+    else if (structure == "std-vector") {
+        StdVector<int> ds;
+        f(ds);
+    }
+    else if (structure == "std-list") {
+        StdList<int> ds;
+        f(ds);
+    }
+    else if (structure == "std-deque") {
+        StdDeque<int> ds;
+        f(ds);
+    }
+    else if (structure == "std-set") {
+        StdSet<int> ds;
+        f(ds);
+    }
+    else if (structure == "std-unordered-set") {
+        StdUnorderedSet<int> ds;
+        f(ds);
+    }
+    else if (structure == "std-unordered-map") {
+        StdUnorderedMap<int, int> ds;
+        f(ds);
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+// Память новой структуры после вставки всех data; -1 без -DALLOC_TRACKING
+long long measureFootprint(const string& structure, const vector<int>& data, size_t capacity) {
+    if (!alloctrack::enabled()) return -1;
+    long long bytes = -1;
+    uint64_t before = alloctrack::snapshot().liveBytes;
+    withStructure(structure, capacity, [&](auto& ds) {
+        for (auto x : data) benchInsert(ds, x);
+        bytes = alloctrack::snapshot().liveBytes - before;
+    });
+    return bytes;
+}
+
+// Каждая структура против аналога из стандартной библиотеки на одних данных
+int runBaseline(const string& operation, int n, map<string, string>& options) {
+    BenchConfig cfg = parseBenchConfig(options);
+    WorkloadConfig workload = parseWorkload(options);
+    vector<int> data = generateData(workload, n);
+    bool csv = options.count("format") && options["format"] == "csv";
+
+    auto run = [&](const string& structure, BenchResult& result) {
+        vector<int> copy = data;  // remove в runDSBenchmark меняет данные
+        runBenchmark(structure, operation, copy, n, cfg, result);
+        result.footprintBytes = measureFootprint(structure, data, n);
+    };
+
+    if (csv) {
+        cout << "structure,standard,operation,n,ns_per_op,std_ns_per_op,speedup_vs_std,bytes_per_element,std_bytes_per_element\n";
+    } else {
+        cout << "Сравнение со стандартной библиотекой, операция " << operation << ", элементов: " << n << "\n";
+        cout << "нс/оп — медиана серии на элемент; ускорение > 1 — своя структура быстрее\n";
+    }
+
+    for (const auto& pair : baselinePairs()) {
+        BenchResult own, standard;
+        run(pair.structure, own);
+        run(pair.standard, standard);
+
+        double ownNs = (double)own.series.median / n;
+        double stdNs = (double)standard.series.median / n;
+        double speedup = ownNs > 0 ? stdNs / ownNs : 0;
+        auto perElement = [&](const BenchResult& r) {
+            return r.footprintBytes >= 0 ? (double)r.footprintBytes / n : -1.0;
+        };
+
+        if (csv) {
+            cout << pair.structure << ',' << pair.standard << ',' << operation << ',' << n << ','
+                 << ownNs << ',' << stdNs << ',' << speedup << ',';
+            if (own.footprintBytes >= 0) cout << perElement(own) << ',' << perElement(standard);
+            else cout << ',';
+            cout << endl;
+        } else {
+            cout << pair.structure << " vs " << pair.standard << ": "
+                 << ownNs << " нс/оп против " << stdNs << " нс/оп, ускорение " << speedup << "x";
+            if (own.footprintBytes >= 0) {
+                cout << "; память " << perElement(own) << " против " << perElement(standard) << " байт на элемент";
+            }
+            cout << endl;
+        }
+    }
+    return 0;
+}
+
+// Масштабирование по потокам: benchmark ... --threads=N
+int runThreads(const string& structure, const string& operation, int n, map<string, string>& options) {
+    BenchConfig cfg = parseBenchConfig(options);
+    WorkloadConfig workload = parseWorkload(options);
+    int maxThreads = stoi(options["threads"]);
+    if (maxThreads < 1) throw invalid_argument("Число потоков должно быть положительным");
+    bool shared = !options.count("independent");
+    MixedRatio ratio = options.count("ratio") ? parseMixedRatio(options["ratio"]) : MixedRatio{};
+
+    bool known = withStructure(structure, 1, [](auto&) {});
+    if (!known) {
+        cerr << "Неизвестная структура: " << structure << "\n";
+        return 1;
+    }
+
+    auto make = [&](size_t capacity, auto f) { withStructure(structure, capacity, f); };
+    vector<ThreadPoint> points = runThreadScaling(make, operation, workload, n, maxThreads, shared, ratio, cfg);
+
+    bool csv = options.count("format") && options["format"] == "csv";
+    if (csv) {
+        cout << "structure,operation,n,mode,threads,ops,median_ns,ops_per_sec,efficiency\n";
+    } else {
+        cout << "Масштабирование по потокам: " << structure << ", операция " << operation
+             << ", " << n << " операций на поток (ядер: " << thread::hardware_concurrency() << ")\n";
+    }
+    for (const auto& p : points) {
+        if (csv) {
+            cout << structure << ',' << operation << ',' << n << ',' << p.mode << ',' << p.threads << ','
+                 << p.ops << ',' << p.stats.median << ',' << p.throughput << ',' << p.efficiency << "\n";
+        } else {
+            const char* mode = p.mode == "shared" ? "общая под мьютексом"
+                             : p.mode == "concurrent" ? "общая без мьютекса" : "своя в каждом потоке";
+            cout << mode
+                 << ", потоков " << p.threads << ": " << p.throughput << " оп/с, эффективность "
+                 << p.efficiency * 100 << "%\n";
+        }
+    }
+    return 0;
+}
+
+// Время contains по ходу длительной серии вставок и удалений
+int runChurn(const string& structure, int n, map<string, string>& options) {
+    BenchConfig cfg = parseBenchConfig(options);
+    long long cycles = options.count("cycles") ? stoll(options["cycles"]) : 1000000;
+    int points = options.count("points") ? stoi(options["points"]) : 10;
+    bool csv = options.count("format") && options["format"] == "csv";
+
+    // lockfreehash не освобождает ячейки удалённых ключей: ему нужна
+    // ёмкость на все n + cycles разных ключей прогона
+    size_t capacity = 2 * static_cast<size_t>(n);
+    if (structure == "lockfreehash") capacity = static_cast<size_t>(n + max(cycles, 0LL));
+
+    vector<ChurnPoint> curve;
+    bool known = withStructure(structure, capacity, [&](auto& ds) {
+        curve = runChurnBenchmark(ds, n, cycles, points, cfg);
+    });
+    if (!known) {
+        cerr << "Неизвестная структура: " << structure << "\n";
+        return 1;
+    }
+
+    if (csv) {
+        cout << "structure,n,cycles,hit_ns_per_op,miss_ns_per_op\n";
+    } else {
+        cout << "Устойчивое обновление: " << structure << ", элементов: " << n
+             << ", циклов вставка+удаление: " << cycles << "\n";
+        cout << "contains, нс/оп — медиана серии на элемент\n";
+    }
+    for (const auto& p : curve) {
+        double hit = (double)p.hit.median / n;
+        double miss = (double)p.miss.median / n;
+        if (csv) {
+            cout << structure << ',' << n << ',' << p.cycles << ',' << hit << ',' << miss << "\n";
+        } else {
+            cout << "после " << p.cycles << " циклов: есть в структуре " << hit
+                 << " нс/оп, нет в структуре " << miss << " нс/оп\n";
+        }
+    }
+    return 0;
+}
+
+// --key=value попадает в options, остальное — позиционные аргументы
+void parseArgs(int argc, char* argv[], vector<string>& args, map<string, string>& options) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.rfind("--", 0) == 0) {
+            size_t eq = arg.find('=');
+            if (eq == string::npos) {
+                options[arg.substr(2)] = "";
+            } else {
+                options[arg.substr(2, eq - 2)] = arg.substr(eq + 1);
+            }
+        } else {
+            args.push_back(arg);
+        }
+    }
+}
+
+void printStats(const string& title, const BenchStats& s) {
+    cout << title << " (нс): min=" << s.min
+         << " median=" << s.median
+         << " p90=" << s.p90
+         << " p99=" << s.p99
+         << " max=" << s.max
+         << " mean=" << s.mean
+         << " stddev=" << s.stddev << "\n";
+}
+
+void printLatency(const LatencyHistogram& h) {
+    cout << "Задержка одной операции (нс), операций: " << h.count() << "\n";
+    cout << "  min=" << h.min()
+         << " p50=" << h.percentile(50)
+         << " p90=" << h.percentile(90)
+         << " p99=" << h.percentile(99)
+         << " p999=" << h.percentile(99.9)
+         << " max=" << h.max()
+         << " mean=" << h.mean() << "\n";
+}
+
+void printAlloc(const string& title, const AllocTotals& a, size_t opsPerRun) {
+    cout << title << ": выделений=" << a.allocationsPerOp(opsPerRun)
+         << " освобождений=" << a.freesPerOp(opsPerRun)
+         << ", пиковый прирост за замер: " << a.peakBytes << " байт\n";
+}
+
+void printPerf(const string& title, const PerfTotals& p, size_t opsPerRun) {
+    cout << title << ":";
+    bool any = false;
+    for (int e = 0; e < PerfCounters::EVENT_COUNT; ++e) {
+        if (!p.available[e]) continue;
+        cout << " " << PerfCounters::name(e) << "=" << p.perOp(e, opsPerRun);
+        any = true;
+    }
+    if (!any) {
+        cout << " недоступны (нет поддержки perf_event_open или kernel.perf_event_paranoid запрещает)";
+    } else if (p.available[PerfCounters::CYCLES] && p.available[PerfCounters::INSTRUCTIONS]
+               && p.total[PerfCounters::CYCLES] > 0) {
+        cout << " IPC=" << static_cast<double>(p.total[PerfCounters::INSTRUCTIONS]) / p.total[PerfCounters::CYCLES];
+    }
+    cout << "\n";
+}
+
+void printReport(const BenchInfo& info, const BenchConfig& cfg, const BenchResult& result) {
+    cout << "Результаты бенчмарка:\n";
+    cout << "Структура: " << info.structure << "\n";
+    cout << "Операция: " << info.operation << "\n";
+    cout << "Количество элементов: " << info.n << "\n";
+    cout << "Распределение ключей: " << info.distribution << " (seed " << info.seed << ")\n";
+    cout << "Прогревочных запусков: " << cfg.warmup << ", замеров: " << cfg.repeats << "\n";
+
+    if (info.ops > 0) {
+        cout << "Смешанная нагрузка (чтение:вставка:удаление): " << info.ratio << ", операций: " << info.ops << "\n";
+        printStats("Время для серии из " + to_string(info.ops) + " операций", result.series);
+        cout << "Пропускная способность (медиана): " << throughput(info.ops, result.series) << " оп/с\n";
+    } else {
+        printStats("Время для серии из " + to_string(info.n) + " элементов", result.series);
+        cout << "Среднее время на элемент (медиана): " << (double)result.series.median / info.n << " нс\n";
+    }
+
+    if (result.hasOnce) {
+        printStats("Время для одного элемента", result.once);
+
+        if (result.once.median > 0 && result.series.median > 0) {
+            double speedup = (double)result.once.median * info.n / result.series.median;
+            cout << "Ускорение при серийной обработке: " << speedup << "x\n";
+        }
+    }
+
+    if (result.hasPerKey) {
+        printStats("Поштучный contains по тем же ключам", result.perKey);
+
+        if (result.perKey.median > 0 && result.series.median > 0) {
+            double speedup = (double)result.perKey.median / result.series.median;
+            cout << "Ускорение пакетного поиска: " << speedup << "x\n";
+        }
+    }
+
+    if (result.series.alloc.enabled) {
+        printAlloc("Память на операцию серии", result.series.alloc, seriesOps(info));
+        if (result.hasOnce) printAlloc("Память для одного элемента", result.once.alloc, 1);
+    }
+    if (result.footprintBytes >= 0) {
+        cout << "Размер структуры из " << info.n << " элементов: " << result.footprintBytes << " байт ("
+             << (info.n > 0 ? (double)result.footprintBytes / info.n : 0) << " байт на элемент)\n";
+    }
+
+    if (cfg.perf) {
+        printPerf("Счётчики на операцию серии", result.series.perf, seriesOps(info));
+        if (result.hasOnce) printPerf("Счётчики для одного элемента", result.once.perf, 1);
+    }
+
+    if (cfg.latency) {
+        printLatency(result.latency);
+    }
+}
+
 int main(int argc, char* argv[]) {
     try {
-        if (argc <= 1) {
+        vector<string> args;
+        map<string, string> options;
+        parseArgs(argc, argv, args, options);
+
+        if (args.empty()) {
             help();
             return 1;
         }
 
-        string mode = argv[1];  // benchmark / interactive
+        string mode = args[0];  // benchmark / interactive
         if (mode == "benchmark") {
-            if (argc < 3) {
+            if (args.size() < 3) {
                 help();
                 return 1;
             }
             
-            string structure = argv[2];
-            string operation = argv[3];
-            int n = (argc >= 5) ? stoi(argv[4]) : 50000;
-            
-            vector<int> data(n);
-            mt19937 rng(42);
-            uniform_int_distribution<int> dist(0, n * 10);
+            string structure = args[1];
+            string operation = args[2];
+            int n = (args.size() >= 4) ? stoi(args[3]) : 50000;
 
-            for (auto &x : data) {
-                x = dist(rng);
+            if (options.count("threads")) {
+                return runThreads(structure, operation, n, options);
             }
 
-            long long timeOnce = 0;
-            long long timeSeries = 0;
+            BenchConfig cfg = parseBenchConfig(options);
+            WorkloadConfig workload = parseWorkload(options);
+
+            vector<int> data = generateData(workload, n);
+
+            BenchResult result;
+            BenchInfo info;
+            info.structure = structure;
+            info.operation = operation;
+            info.n = n;
+            info.distribution = workload.distribution;
+            info.seed = workload.seed;
 
             // бенчмарк
-            if (structure == "array") {
-                runDSBenchmark<Array<int>>(operation, data, n, timeOnce, timeSeries);
-            }
-            else if (structure == "linkedlist") {
-                runDSBenchmark<LinkedList<int>>(operation, data, n, timeOnce, timeSeries);
+            if (operation == "mixed") {
+                int ops = options.count("ops") ? stoi(options["ops"]) : n;
+                MixedRatio ratio = options.count("ratio") ? parseMixedRatio(options["ratio"]) : MixedRatio{};
+                vector<MixedOp> stream = generateMixedOps(workload, data, ops, ratio);
+
+                cfg.latency = true;
+                info.ops = ops;
+                info.ratio = to_string(ratio.read) + ":" + to_string(ratio.insert) + ":" + to_string(ratio.remove);
+
+                // вставки добавляют до ops ключей сверх n
+                bool known = withStructure(structure, n + ops, [&](auto& ds) {
+                    runMixedBenchmark(ds, data, stream, cfg, result);
+                });
+                if (!known) {
+                    cerr << "Неизвестная структура: " << structure << "\n";
+                    return 1;
+                }
             }
-            else if (structure == "forwardlist") {
-                runDSBenchmark<ForwardList<int>>(operation, data, n, timeOnce, timeSeries);
+            else if (!runBenchmark(structure, operation, data, n, cfg, result)) {
+                cerr << "Неизвестная структура: " << structure << "\n";
+                return 1;
             }
-            else if (structure == "queue") {
-                runDSBenchmark<Queue<int>>(operation, data, n, timeOnce, timeSeries);
+
+            result.footprintBytes = measureFootprint(structure, data, n);
+
+            string format = options.count("format") ? options["format"] : "text";
+            if (format == "json") {
+                cout << reportToJson(info, cfg, result).dump(4) << "\n";
             }
-            else if (structure == "stack") {
-                runDSBenchmark<Stack<int>>(operation, data, n, timeOnce, timeSeries);
+            else if (format == "csv") {
+                reportToCsv(cout, info, cfg, result);
             }
-            else if (structure == "avltree") {
-                runHashBenchmark<AVLTree<int>>(operation, data, n, timeOnce, timeSeries);
+            else {
+                printReport(info, cfg, result);
             }
-            else if (structure == "doublehash") {
-                runHashBenchmark<DoubleHashingSet<int>>(operation, data, n, timeOnce, timeSeries);
+            return 0;
+        } else if (mode == "sweep") {
+            if (args.size() < 3) {
+                help();
+                return 1;
             }
-            else if (structure == "linearprobinghash") {
-                LinearProbingHashMap<int, int> lph(n);
-                if (operation == "find" || operation == "remove") {
-                    for (auto x : data) lph.put(x, x + 1);
-                }
-
-                if (operation == "insert") {
-                    timeSeries = benchmark([&]() {
-                        for (auto x : data) lph.put(x, x + 1);
-                    });
-                }
-                else if (operation == "find") {
-                    timeSeries = benchmark([&]() {
-                        for (auto x : data) lph.contains(x);
-                    });
-                }
-                else if (operation == "remove") {
-                    timeSeries = benchmark([&]() {
-                        for (auto x : data) lph.remove(x);
-                    });
-                }
+            return runSweep(args[1], args[2], options);
+        } else if (mode == "baseline") {
+            if (args.size() < 2) {
+                help();
+                return 1;
             }
-            else if (structure == "separatechaininghash") {
-                SeparateChainingHashMap<int, int> sch;
-                if (operation == "find" || operation == "remove") {
-                    for (auto x : data) sch.put(x, x + 1);
-                }
-
-                if (operation == "insert") {
-                    timeSeries = benchmark([&]() { for (auto x : data) sch.put(x, x + 1); });
-                }
-                if (operation == "find") {
-                    timeSeries = benchmark([&]() { for (auto x : data) sch.contains(x); });
-                }
-                if (operation == "remove") {
-                    timeSeries = benchmark([&]() { for (auto x : data) sch.remove(x); });
-                }
+            int n = (args.size() >= 3) ? stoi(args[2]) : 50000;
+            return runBaseline(args[1], n, options);
+        } else if (mode == "churn") {
+            if (args.size() < 2) {
+                help();
+                return 1;
             }
-            else {
-                cerr << "Неизвестная структура: " << structure << "\n";
+            int n = (args.size() >= 3) ? stoi(args[2]) : 50000;
+            return runChurn(args[1], n, options);
+        } else if (mode == "compare") {
+            if (args.size() < 3) {
+                help();
                 return 1;
             }
 
-            cout << "Результаты бенчмарка:\n";
-            cout << "Структура: " << structure << "\n";
-            cout << "Операция: " << operation << "\n";
-            cout << "Количество элементов: " << n << "\n";
-            
-            if (operation == "insert") {
-                cout << "Общее время: " << timeSeries << " мс\n";
-                cout << "Среднее время на элемент: " 
-                    << (timeSeries > 0 ? (double)timeSeries / n : 0) << " мс\n";
-            } else {
-                cout << "Время для одного элемента: " << timeOnce << " мс\n";
-                cout << "Время для серии из " << n << " элементов: " 
-                    << timeSeries << " мс\n";
-                
-                if (timeOnce > 0 && timeSeries > 0) {
-                    double speedup = (double)(timeOnce * n) / timeSeries;
-                    cout << "Ускорение при серийной обработке: " << speedup << "x\n";
-                }
+            double threshold = options.count("threshold") ? stod(options["threshold"]) : 10.0;
+            vector<json> baseline = loadReports(args[1]);
+            vector<json> current = loadReports(args[2]);
+
+            int regressions = compareReports(baseline, current, threshold, cout);
+            if (regressions > 0) {
+                cout << "Регрессий больше " << threshold << "%: " << regressions << "\n";
+                return 2;
             }
+            cout << "Регрессий нет\n";
             return 0;
         } else if (mode == "interactive") {  // serialization / deserialization
-            if (argc < 3) {
+            if (args.size() < 2) {
                 help();
                 return 1;
             }
 
-            string structure = argv[2];
+            string structure = args[1];
 
             if (structure == "array") {
                 runInteractive<Array<int>>("Array");
@@ -189,9 +784,27 @@ int main(int argc, char* argv[]) {
             else if (structure == "linearprobinghash") {
                 runInteractiveHash<LinearProbingHashMap<int,int>>("LinearProbingHash");
             }
+            else if (structure == "robinhoodhash") {
+                runInteractiveHash<RobinHoodHashMap<int,int>>("RobinHoodHash");
+            }
+            else if (structure == "swisshash") {
+                runInteractiveHash<SwissHashMap<int,int>>("SwissHash");
+            }
             else if (structure == "doublehash") {
                 runInteractive<DoubleHashingSet<int>>("DoubleHashingHash");
             }
+            else if (structure == "cuckoohash") {
+                runInteractive<CuckooHashSet<int>>("CuckooHash");
+            }
+            else if (structure == "lockfreehash") {
+                runInteractive<LockFreeHashSet<int>>("LockFreeHash");
+            }
+            else if (structure == "cuckoohashmap") {
+                runInteractiveHash<CuckooHashMap<int,int>>("CuckooHashMap");
+            }
+            else if (structure == "shardedhash") {
+                runInteractiveHash<ShardedHashMap<int,int>>("ShardedHash");
+            }
             else {
                 cerr << "Неизвестная структура: " << structure << "\n";
                 return 1;
@@ -199,6 +812,7 @@ int main(int argc, char* argv[]) {
         }
     } catch (const exception& e) {
         cerr << "Ошибка: " << e.what() << endl;
+        return 1;
     }
 
     return 0;
@@ -0,0 +1,152 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Аппаратные счётчики через perf_event_open (только Linux).
+// Каждое событие открывается отдельно: если процессор или ядро
+// не поддерживает какое-то событие, остальные продолжают работать
+class PerfCounters {
+public:
+    enum Event {
+        CYCLES,
+        INSTRUCTIONS,
+        L1D_MISSES,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        DTLB_MISSES,
+        EVENT_COUNT
+    };
+
+    static const char* name(int e) {
+        static const char* names[EVENT_COUNT] = {
+            "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses"
+        };
+        return names[e];
+    }
+
+private:
+    int fds[EVENT_COUNT];
+
+#ifdef __linux__
+    static uint64_t cacheConfig(uint64_t cache, uint64_t op, uint64_t result) {
+        return cache | (op << 8) | (result << 16);
+    }
+
+    static int open(uint32_t type, uint64_t config) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+
+public:
+    PerfCounters() {
+        for (int& fd : fds) fd = -1;
+#ifdef __linux__
+        fds[CYCLES] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        fds[INSTRUCTIONS] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        fds[L1D_MISSES] = open(PERF_TYPE_HW_CACHE, cacheConfig(PERF_COUNT_HW_CACHE_L1D,
+            PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS));
+        fds[LLC_MISSES] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        fds[BRANCH_MISSES] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        fds[DTLB_MISSES] = open(PERF_TYPE_HW_CACHE, cacheConfig(PERF_COUNT_HW_CACHE_DTLB,
+            PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS));
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available(int e) const { return fds[e] >= 0; }
+
+    bool anyAvailable() const {
+        for (int fd : fds) {
+            if (fd >= 0) return true;
+        }
+        return false;
+    }
+
+    void start() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    void stop() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+#endif
+    }
+
+    // Значение с поправкой на мультиплексирование счётчиков ядром
+    uint64_t read(int e) const {
+#ifdef __linux__
+        if (fds[e] < 0) return 0;
+        uint64_t buf[3] = {0, 0, 0};  // value, time_enabled, time_running
+        if (::read(fds[e], buf, sizeof(buf)) != sizeof(buf)) return 0;
+        if (buf[2] == 0) return 0;
+        if (buf[2] < buf[1]) {
+            return static_cast<uint64_t>(static_cast<double>(buf[0]) * buf[1] / buf[2]);
+        }
+        return buf[0];
+#else
+        (void)e;
+        return 0;
+#endif
+    }
+};
+
+// Суммы счётчиков по всем замерам одного вида
+struct PerfTotals {
+    bool enabled = false;
+    bool available[PerfCounters::EVENT_COUNT] = {};
+    uint64_t total[PerfCounters::EVENT_COUNT] = {};
+    size_t runs = 0;
+
+    void add(const PerfCounters& pc) {
+        enabled = true;
+        for (int e = 0; e < PerfCounters::EVENT_COUNT; ++e) {
+            available[e] = pc.available(e);
+            total[e] += pc.read(e);
+        }
+        runs++;
+    }
+
+    // Среднее на одну операцию, если за замер выполнялось opsPerRun операций
+    double perOp(int e, size_t opsPerRun) const {
+        if (runs == 0 || opsPerRun == 0) return 0;
+        return static_cast<double>(total[e]) / runs / opsPerRun;
+    }
+};
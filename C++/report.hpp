@@ -0,0 +1,231 @@
+#pragma once
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+
+#include "benchmark.hpp"
+#include "json.hpp"
+
+using namespace std;
+using json = nlohmann::json;
+
+// Описание запуска, попадает в отчёт рядом с результатами
+struct BenchInfo {
+    string structure;
+    string operation;
+    int n = 0;
+    string distribution = "uniform";
+    unsigned seed = 42;
+    int ops = 0;    // только для смешанной нагрузки
+    string ratio;
+};
+
+// Операций в секунду по медиане серии из ops операций
+inline double throughput(int ops, const BenchStats& s) {
+    return s.median > 0 ? ops * 1e9 / s.median : 0;
+}
+
+inline json statsToJson(const BenchStats& s) {
+    return json{
+        {"runs", s.runs},
+        {"min_ns", s.min},
+        {"median_ns", s.median},
+        {"p90_ns", s.p90},
+        {"p99_ns", s.p99},
+        {"max_ns", s.max},
+        {"mean_ns", s.mean},
+        {"stddev_ns", s.stddev}
+    };
+}
+
+inline json latencyToJson(const LatencyHistogram& h) {
+    return json{
+        {"count", h.count()},
+        {"min_ns", h.min()},
+        {"p50_ns", h.percentile(50)},
+        {"p90_ns", h.percentile(90)},
+        {"p99_ns", h.percentile(99)},
+        {"p999_ns", h.percentile(99.9)},
+        {"max_ns", h.max()},
+        {"mean_ns", h.mean()}
+    };
+}
+
+// Счётчики на одну операцию; недоступные события — null
+inline json perfToJson(const PerfTotals& p, size_t opsPerRun) {
+    json j = json::object();
+    for (int e = 0; e < PerfCounters::EVENT_COUNT; ++e) {
+        string key = string(PerfCounters::name(e)) + "_per_op";
+        if (p.available[e]) j[key] = p.perOp(e, opsPerRun);
+        else j[key] = nullptr;
+    }
+    return j;
+}
+
+// Число операций в одном замере серии
+inline size_t seriesOps(const BenchInfo& info) {
+    return info.ops > 0 ? info.ops : info.n;
+}
+
+inline json allocToJson(const AllocTotals& a, size_t opsPerRun) {
+    return json{
+        {"allocations_per_op", a.allocationsPerOp(opsPerRun)},
+        {"frees_per_op", a.freesPerOp(opsPerRun)},
+        {"peak_bytes", a.peakBytes}
+    };
+}
+
+inline json reportToJson(const BenchInfo& info, const BenchConfig& cfg, const BenchResult& result) {
+    json j{
+        {"structure", info.structure},
+        {"operation", info.operation},
+        {"n", info.n},
+        {"distribution", info.distribution},
+        {"seed", info.seed},
+        {"warmup", cfg.warmup},
+        {"repeats", cfg.repeats},
+        {"series", statsToJson(result.series)}
+    };
+    if (result.hasOnce) j["once"] = statsToJson(result.once);
+    if (result.hasPerKey) j["per_key"] = statsToJson(result.perKey);
+    if (cfg.perf) {
+        j["series"]["perf"] = perfToJson(result.series.perf, seriesOps(info));
+        if (result.hasOnce) j["once"]["perf"] = perfToJson(result.once.perf, 1);
+    }
+    if (result.series.alloc.enabled) {
+        j["series"]["alloc"] = allocToJson(result.series.alloc, seriesOps(info));
+        if (result.hasOnce) j["once"]["alloc"] = allocToJson(result.once.alloc, 1);
+    }
+    if (result.footprintBytes >= 0) {
+        j["footprint_bytes"] = result.footprintBytes;
+        j["bytes_per_element"] = info.n > 0 ? static_cast<double>(result.footprintBytes) / info.n : 0;
+    }
+    if (info.ops > 0) {
+        j["ops"] = info.ops;
+        j["ratio"] = info.ratio;
+        j["throughput_ops"] = throughput(info.ops, result.series);
+    }
+    if (cfg.latency) j["latency"] = latencyToJson(result.latency);
+    return j;
+}
+
+// Одна строка на вид замера: series, once, per_key, latency. У смешанной
+// нагрузки в конце ops, ratio и throughput_ops, как в JSON
+inline void reportToCsv(ostream& out, const BenchInfo& info, const BenchConfig& cfg, const BenchResult& result) {
+    out << "structure,operation,n,distribution,seed,warmup,repeats,kind,count,min_ns,median_ns,p90_ns,p99_ns,p999_ns,max_ns,mean_ns,stddev_ns";
+    if (cfg.perf) {
+        for (int e = 0; e < PerfCounters::EVENT_COUNT; ++e) out << ',' << PerfCounters::name(e) << "_per_op";
+    }
+    bool alloc = result.series.alloc.enabled;
+    if (alloc) out << ",allocations_per_op,frees_per_op,peak_bytes";
+    bool mixed = info.ops > 0;
+    if (mixed) out << ",ops,ratio,throughput_ops";
+    out << '\n';
+    auto prefix = [&]() {
+        out << info.structure << ',' << info.operation << ',' << info.n << ','
+            << info.distribution << ',' << info.seed << ',' << cfg.warmup << ',' << cfg.repeats << ',';
+    };
+    // пропускная способность — только у строки series
+    auto mixedColumns = [&](bool series) {
+        if (!mixed) return;
+        out << ',' << info.ops << ',' << info.ratio << ',';
+        if (series) out << throughput(info.ops, result.series);
+    };
+    auto row = [&](const string& kind, const BenchStats& s, size_t opsPerRun) {
+        prefix();
+        out << kind << ',' << s.runs << ',' << s.min << ',' << s.median << ',' << s.p90 << ','
+            << s.p99 << ",," << s.max << ',' << s.mean << ',' << s.stddev;
+        if (cfg.perf) {
+            for (int e = 0; e < PerfCounters::EVENT_COUNT; ++e) {
+                out << ',';
+                if (s.perf.available[e]) out << s.perf.perOp(e, opsPerRun);
+            }
+        }
+        if (alloc) {
+            out << ',' << s.alloc.allocationsPerOp(opsPerRun) << ',' << s.alloc.freesPerOp(opsPerRun)
+                << ',' << s.alloc.peakBytes;
+        }
+        mixedColumns(kind == "series");
+        out << '\n';
+    };
+
+    row("series", result.series, seriesOps(info));
+    if (result.hasOnce) row("once", result.once, 1);
+    if (result.hasPerKey) row("per_key", result.perKey, seriesOps(info));
+    if (cfg.latency) {
+        const LatencyHistogram& h = result.latency;
+        prefix();
+        out << "latency," << h.count() << ',' << h.min() << ',' << h.percentile(50) << ','
+            << h.percentile(90) << ',' << h.percentile(99) << ',' << h.percentile(99.9) << ','
+            << h.max() << ',' << h.mean() << ',';
+        if (cfg.perf) out << string(PerfCounters::EVENT_COUNT, ',');
+        if (alloc) out << ",,,";
+        mixedColumns(false);
+        out << '\n';
+    }
+}
+
+// Файл с результатами: один отчёт (объект) или массив отчётов
+inline vector<json> loadReports(const string& path) {
+    ifstream in(path);
+    if (!in) throw runtime_error("Не удалось открыть файл: " + path);
+    json j;
+    in >> j;
+    if (j.is_array()) return j.get<vector<json>>();
+    return {j};
+}
+
+// Запуски сравнимы, только если совпадают все параметры нагрузки;
+// ops и ratio есть лишь у смешанной нагрузки
+inline string reportKey(const json& r) {
+    string key = r.at("structure").get<string>() + " " + r.at("operation").get<string>()
+               + " n=" + to_string(r.at("n").get<int>())
+               + " " + r.value("distribution", string("uniform"));
+    if (r.contains("ops")) {
+        key += " ops=" + to_string(r.at("ops").get<int>()) + " ratio=" + r.value("ratio", string());
+    }
+    return key;
+}
+
+// Сравнивает медиану серии с базовой. Возвращает число регрессий
+// больше threshold процентов
+inline int compareReports(const vector<json>& baseline, const vector<json>& current,
+                          double threshold, ostream& out) {
+    int regressions = 0;
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    out << fixed << setprecision(1);
+
+    for (const json& cur : current) {
+        string key = reportKey(cur);
+        const json* base = nullptr;
+        for (const json& b : baseline) {
+            if (reportKey(b) == key) {
+                base = &b;
+                break;
+            }
+        }
+        if (!base) {
+            out << key << ": нет базового результата\n";
+            continue;
+        }
+
+        double before = base->at("series").at("median_ns").get<double>();
+        double after = cur.at("series").at("median_ns").get<double>();
+        double change = before > 0 ? (after - before) / before * 100.0 : 0;
+
+        out << key << ": " << before << " -> " << after << " нс (" << showpos << change << noshowpos << "%)";
+        if (change > threshold) {
+            out << " РЕГРЕССИЯ";
+            regressions++;
+        }
+        out << "\n";
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+    return regressions;
+}
@@ -0,0 +1,179 @@
+#pragma once
+#include <vector>
+#include <list>
+#include <deque>
+#include <set>
+#include <unordered_set>
+#include <unordered_map>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+using namespace std;
+
+// Обёртки над контейнерами стандартной библиотеки с тем же интерфейсом,
+// что у структур в include/: их можно подставить в те же бенчмарки
+
+template<typename T>
+class StdVector {
+private:
+    vector<T> v;
+
+public:
+    void push_back(const T& x) { v.push_back(x); }
+
+    T& at(int index) {
+        if (index < 0 || index >= static_cast<int>(v.size())) throw out_of_range("Index out of range");
+        return v[index];
+    }
+
+    int find(const T& x) const {
+        auto it = std::find(v.begin(), v.end(), x);
+        return it == v.end() ? -1 : static_cast<int>(it - v.begin());
+    }
+
+    bool contains(const T& x) const { return find(x) != -1; }
+
+    bool remove(const T& x) {
+        auto it = std::find(v.begin(), v.end(), x);
+        if (it == v.end()) return false;
+        v.erase(it);
+        return true;
+    }
+
+    void clear() { v.clear(); }
+    size_t size() const { return v.size(); }
+};
+
+template<typename T>
+class StdList {
+private:
+    list<T> l;
+
+public:
+    void push_back(const T& x) { l.push_back(x); }
+
+    T& at(int index) {
+        if (index < 0 || index >= static_cast<int>(l.size())) throw out_of_range("Index out of range");
+        return *next(l.begin(), index);
+    }
+
+    int find(const T& x) const {
+        int i = 0;
+        for (const T& item : l) {
+            if (item == x) return i;
+            ++i;
+        }
+        return -1;
+    }
+
+    bool contains(const T& x) const { return std::find(l.begin(), l.end(), x) != l.end(); }
+
+    bool remove(const T& x) {
+        auto it = std::find(l.begin(), l.end(), x);
+        if (it == l.end()) return false;
+        l.erase(it);
+        return true;
+    }
+
+    void clear() { l.clear(); }
+    size_t size() const { return l.size(); }
+};
+
+// Аналог Queue: remove() извлекает первый элемент независимо от аргумента
+template<typename T>
+class StdDeque {
+private:
+    deque<T> d;
+
+public:
+    void push_back(const T& x) { d.push_back(x); }
+
+    T& at(int index) {
+        if (index < 0 || index >= static_cast<int>(d.size())) throw out_of_range("Index out of range");
+        return d[index];
+    }
+
+    int find(const T& x) const {
+        auto it = std::find(d.begin(), d.end(), x);
+        return it == d.end() ? -1 : static_cast<int>(it - d.begin());
+    }
+
+    bool contains(const T& x) const { return find(x) != -1; }
+
+    void remove(const T&) {
+        if (!d.empty()) d.pop_front();
+    }
+
+    void clear() { d.clear(); }
+    size_t size() const { return d.size(); }
+};
+
+template<typename T>
+class StdSet {
+private:
+    set<T> s;
+
+public:
+    void push_back(const T& x) { s.insert(x); }
+    bool contains(const T& x) const { return s.count(x) > 0; }
+    bool remove(const T& x) { return s.erase(x) > 0; }
+    void clear() { s.clear(); }
+    size_t size() const { return s.size(); }
+};
+
+template<typename T>
+class StdUnorderedSet {
+private:
+    unordered_set<T> s;
+
+public:
+    void push_back(const T& x) { s.insert(x); }
+    bool contains(const T& x) const { return s.count(x) > 0; }
+    bool remove(const T& x) { return s.erase(x) > 0; }
+    void clear() { s.clear(); }
+    size_t size() const { return s.size(); }
+};
+
+template<typename Key, typename Value>
+class StdUnorderedMap {
+private:
+    unordered_map<Key, Value> m;
+
+public:
+    void put(const Key& key, const Value& value) { m[key] = value; }
+    bool contains(const Key& key) const { return m.count(key) > 0; }
+    bool remove(const Key& key) { return m.erase(key) > 0; }
+
+    Value get(const Key& key) const {
+        auto it = m.find(key);
+        if (it == m.end()) throw runtime_error("Key not found");
+        return it->second;
+    }
+
+    void clear() { m.clear(); }
+    size_t size() const { return m.size(); }
+};
+
+// Пары "своя структура — аналог из стандартной библиотеки" для режима baseline
+struct BaselinePair {
+    const char* structure;
+    const char* standard;
+};
+
+inline const vector<BaselinePair>& baselinePairs() {
+    static const vector<BaselinePair> pairs = {
+        {"array", "std-vector"},
+        {"linkedlist", "std-list"},
+        {"queue", "std-deque"},
+        {"avltree", "std-set"},
+        {"doublehash", "std-unordered-set"},
+        {"cuckoohash", "std-unordered-set"},
+        {"linearprobinghash", "std-unordered-map"},
+        {"robinhoodhash", "std-unordered-map"},
+        {"swisshash", "std-unordered-map"},
+        {"cuckoohashmap", "std-unordered-map"},
+        {"separatechaininghash", "std-unordered-map"},
+    };
+    return pairs;
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "../benchmark.hpp"
+#include "../report.hpp"
+
+// Множество, которое при росте долго перестраивается; clear() сохраняет
+// ёмкость, как у хэш-таблиц
+class SlowGrowSet {
+private:
+    size_t capacity;
+    std::vector<int> keys;
+
+public:
+    static constexpr auto RESIZE_TIME = std::chrono::milliseconds(2);
+    static inline int resizes = 0;
+
+    explicit SlowGrowSet(size_t initial = 32) : capacity(initial) {}
+
+    void push_back(int x) {
+        if (keys.size() == capacity) {
+            capacity *= 2;
+            resizes++;
+            std::this_thread::sleep_for(RESIZE_TIME);
+        }
+        keys.push_back(x);
+    }
+
+    void put(int key, int) { push_back(key); }
+    bool contains(int x) const { return std::find(keys.begin(), keys.end(), x) != keys.end(); }
+
+    bool remove(int x) {
+        auto it = std::find(keys.begin(), keys.end(), x);
+        if (it == keys.end()) return false;
+        keys.erase(it);
+        return true;
+    }
+
+    void clear() { keys.clear(); }
+};
+
+// INSERT: КАЖДЫЙ ПОВТОР НА НОВОЙ СТРУКТУРЕ
+TEST(BenchmarkTest, InsertLatencySeesResizeOnEveryRepeat) {
+    std::vector<int> data(64);
+    for (int i = 0; i < 64; i++) data[i] = i;
+    BenchConfig cfg;
+    cfg.warmup = 1;
+    cfg.repeats = 3;
+    cfg.latency = true;
+
+    SlowGrowSet::resizes = 0;
+    BenchResult result;
+    runSetBenchmark("insert", data, 64, []() { return std::make_unique<SlowGrowSet>(); }, cfg, result);
+
+    // прогрев, замеры серии и проход гистограммы: по одному росту на каждый
+    EXPECT_EQ(SlowGrowSet::resizes, cfg.warmup + 2 * cfg.repeats);
+    EXPECT_EQ(result.latency.count(), static_cast<uint64_t>(cfg.repeats) * data.size());
+    EXPECT_GE(result.latency.max(),
+              static_cast<uint64_t>(std::chrono::nanoseconds(SlowGrowSet::RESIZE_TIME).count()));
+}
+
+TEST(BenchmarkTest, MapInsertUsesCapacityFromFactory) {
+    std::vector<int> data(64);
+    for (int i = 0; i < 64; i++) data[i] = i;
+    BenchConfig cfg;
+    cfg.latency = true;
+
+    SlowGrowSet::resizes = 0;
+    BenchResult grown;
+    runMapBenchmark("insert", data, 64, []() { return std::make_unique<SlowGrowSet>(); }, cfg, grown);
+    EXPECT_EQ(SlowGrowSet::resizes, cfg.warmup + 2 * cfg.repeats);
+
+    // заранее заданная ёмкость: роста нет ни в одном повторе
+    SlowGrowSet::resizes = 0;
+    BenchResult presized;
+    runMapBenchmark("insert", data, 64, []() { return std::make_unique<SlowGrowSet>(64); }, cfg, presized);
+    EXPECT_EQ(SlowGrowSet::resizes, 0);
+    EXPECT_GT(grown.latency.max(), presized.latency.max());
+}
+
+// СМЕШАННАЯ НАГРУЗКА
+TEST(BenchmarkTest, MixedOpsReadAndRemoveOnlyLoadedKeys) {
+    WorkloadConfig workload;
+    workload.distribution = "sequential";  // новые ключи без повторов
+    MixedRatio ratio{1, 1, 2};
+
+    std::vector<MixedOp> ops = generateMixedOps(workload, {}, 2000, ratio);
+
+    // пока в структуре есть ключи, чтение и удаление берут только их
+    std::set<int> present;
+    for (const auto& op : ops) {
+        if (op.type == MixedOp::INSERT) {
+            present.insert(op.key);
+            continue;
+        }
+        if (!present.empty()) {
+            ASSERT_TRUE(present.count(op.key)) << op.key;
+        }
+        if (op.type == MixedOp::REMOVE) present.erase(op.key);
+    }
+}
+
+// СРАВНЕНИЕ ОТЧЁТОВ
+TEST(BenchmarkTest, CompareReportsMatchesMixedRunsByRatioAndOps) {
+    auto report = [](const std::string& ratio, int ops, double median) {
+        return json{{"structure", "swisshash"}, {"operation", "mixed"}, {"n", 1000},
+                    {"distribution", "uniform"}, {"ops", ops}, {"ratio", ratio},
+                    {"series", {{"median_ns", median}}}};
+    };
+    std::vector<json> baseline = {report("50:45:5", 1000, 100), report("95:5:0", 1000, 10)};
+    std::vector<json> current = {report("95:5:0", 1000, 11), report("95:5:0", 2000, 11)};
+
+    std::ostringstream out;
+    out << std::setprecision(3);
+    // 95:5:0 сравнивается со своей базой (+10%), а не с 50:45:5; ops=2000 базы не имеет
+    EXPECT_EQ(compareReports(baseline, current, 50, out), 0);
+    EXPECT_NE(out.str().find("10.0 -> 11.0"), std::string::npos) << out.str();
+    EXPECT_NE(out.str().find("ops=2000 ratio=95:5:0: нет базового результата"), std::string::npos) << out.str();
+
+    // форматирование потока восстановлено
+    EXPECT_FALSE(out.flags() & std::ios::fixed);
+    EXPECT_EQ(out.precision(), 3);
+}
+
+TEST(BenchmarkTest, CsvCarriesMixedRatioOpsAndThroughput) {
+    BenchInfo info;
+    info.structure = "swisshash";
+    info.operation = "mixed";
+    info.n = 1000;
+    info.ops = 2000;
+    info.ratio = "95:5:0";
+    BenchConfig cfg;
+    cfg.latency = true;
+    BenchResult result;
+    result.series = computeStats({1000000, 1000000, 1000000});
+    result.latency.record(100);
+
+    std::ostringstream out;
+    reportToCsv(out, info, cfg, result);
+
+    std::istringstream lines(out.str());
+    std::string header, series, latency;
+    std::getline(lines, header);
+    std::getline(lines, series);
+    std::getline(lines, latency);
+
+    EXPECT_NE(header.find(",ops,ratio,throughput_ops"), std::string::npos) << header;
+    // 2000 операций за 1 мс — 2e6 оп/с
+    EXPECT_NE(series.find(",2000,95:5:0,2e+06"), std::string::npos) << series;
+    EXPECT_NE(latency.find(",2000,95:5:0,"), std::string::npos) << latency;
+    auto columns = [](const std::string& line) { return std::count(line.begin(), line.end(), ','); };
+    EXPECT_EQ(columns(series), columns(header));
+    EXPECT_EQ(columns(latency), columns(header));
+}
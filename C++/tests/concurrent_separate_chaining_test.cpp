@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <map>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <vector>
+
+#include "ConcurrentSeparateChainingHashTable.hpp"
+#include "../../json.hpp"
+
+// БАЗОВЫЕ ОПЕРАЦИИ
+TEST(ConcurrentSeparateChainingTest, PutGetRemove) {
+    ConcurrentSeparateChainingHashMap<int, int> map;
+    EXPECT_TRUE(map.empty());
+
+    map.put(1, 10);
+    map.put(2, 20);
+    map.put(1, 15);
+
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ(map.get(1), 15);
+    EXPECT_TRUE(map.contains(2));
+    EXPECT_THROW(map.get(3), std::runtime_error);
+
+    int value = 0;
+    EXPECT_TRUE(map.tryGet(2, value));
+    EXPECT_EQ(value, 20);
+    EXPECT_FALSE(map.tryGet(3, value));
+
+    EXPECT_TRUE(map.remove(1));
+    EXPECT_FALSE(map.remove(1));
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(ConcurrentSeparateChainingTest, GrowsAndMatchesReference) {
+    ConcurrentSeparateChainingHashMap<int, int> map;
+    size_t initialBuckets = map.bucketCount();
+    std::map<int, int> reference;
+    std::mt19937 rng(3);
+
+    for (int i = 0; i < 30000; i++) {
+        int key = static_cast<int>(rng() % 8000);
+        if (rng() % 4) {
+            map.put(key, i);
+            reference[key] = i;
+        } else {
+            EXPECT_EQ(map.remove(key), reference.erase(key) > 0);
+        }
+    }
+
+    EXPECT_GT(map.bucketCount(), initialBuckets);
+    EXPECT_EQ(map.size(), reference.size());
+    EXPECT_EQ(map.items().size(), reference.size());
+    for (const auto& [key, value] : reference) {
+        ASSERT_EQ(map.get(key), value);
+    }
+}
+
+// НЕСКОЛЬКО ПОТОКОВ
+TEST(ConcurrentSeparateChainingTest, ParallelWritersOnOwnKeys) {
+    ConcurrentSeparateChainingHashMap<int, int> map;
+    const int threads = 4;
+    const int perThread = 20000;
+    std::vector<std::map<int, int>> expected(threads);
+    std::vector<std::thread> pool;
+
+    // у потока t ключи с остатком t: итог каждого потока известен точно
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&, t]() {
+            std::mt19937 rng(t);
+            for (int i = 0; i < perThread; i++) {
+                int key = static_cast<int>(rng() % 5000) * threads + t;
+                if (rng() % 3) {
+                    map.put(key, i);
+                    expected[t][key] = i;
+                } else {
+                    map.remove(key);
+                    expected[t].erase(key);
+                }
+            }
+        });
+    }
+    for (auto& th : pool) th.join();
+
+    size_t total = 0;
+    for (const auto& part : expected) {
+        total += part.size();
+        for (const auto& [key, value] : part) ASSERT_EQ(map.get(key), value);
+    }
+    EXPECT_EQ(map.size(), total);
+}
+
+TEST(ConcurrentSeparateChainingTest, ReadersSeeStableKeysDuringGrowth) {
+    ConcurrentSeparateChainingHashMap<int, int> map;
+    const int stable = 2000;
+    for (int k = 0; k < stable; k++) map.put(k, k * 3);
+    size_t initialBuckets = map.bucketCount();
+
+    std::atomic<bool> writing{true};
+    std::atomic<int> misses{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; r++) {
+        readers.emplace_back([&, r]() {
+            int k = r;
+            // хотя бы один полный проход, даже если запись уже закончилась
+            for (int pass = 0; writing.load() || pass < stable; pass++) {
+                int value = -1;
+                if (!map.tryGet(k, value) || value != k * 3) misses++;
+                k = (k + 7) % stable;
+            }
+        });
+    }
+
+    std::thread writer([&]() {
+        for (int k = stable; k < 100000; k++) map.put(k, k * 3);
+        writing = false;
+    });
+
+    writer.join();
+    for (auto& th : readers) th.join();
+
+    EXPECT_EQ(misses.load(), 0);
+    EXPECT_GT(map.bucketCount(), initialBuckets);
+    EXPECT_EQ(map.size(), 100000u);
+}
+
+// CLEAR / SERIALIZATION
+TEST(ConcurrentSeparateChainingTest, ClearKeepsCapacity) {
+    ConcurrentSeparateChainingHashMap<int, int> map;
+    for (int i = 0; i < 5000; i++) map.put(i, i);
+    size_t buckets = map.bucketCount();
+
+    map.clear();
+
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(10));
+    EXPECT_EQ(map.bucketCount(), buckets);
+    map.put(10, 1);
+    EXPECT_EQ(map.get(10), 1);
+}
+
+TEST(ConcurrentSeparateChainingTest, JsonAndBinaryRoundTrip) {
+    ConcurrentSeparateChainingHashMap<int, int> map;
+    for (int i = 0; i < 300; i++) map.put(i, i + 1);
+
+    nlohmann::json j;
+    map.to_json(j);
+    ConcurrentSeparateChainingHashMap<int, int> fromJson;
+    fromJson.from_json(j);
+
+    std::stringstream ss;
+    map.to_binary(ss);
+    ConcurrentSeparateChainingHashMap<int, int> fromBinary;
+    fromBinary.from_binary(ss);
+
+    EXPECT_EQ(fromJson.size(), 300u);
+    EXPECT_EQ(fromBinary.size(), 300u);
+    for (int i = 0; i < 300; i++) {
+        EXPECT_EQ(fromJson.get(i), i + 1);
+        EXPECT_EQ(fromBinary.get(i), i + 1);
+    }
+}
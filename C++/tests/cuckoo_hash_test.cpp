@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <set>
+#include <random>
+
+#include "CuckooHashTable.hpp"
+#include "map_reference_check.hpp"
+#include "../../json.hpp"
+
+// Все ключи претендуют на одни и те же две корзины
+struct ConstantHash {
+    size_t operator()(int) const { return 7; }
+};
+
+// MAP: PUT / GET / REMOVE
+TEST(CuckooHashMapTest, PutGetAndUpdate) {
+    CuckooHashMap<int, int> map;
+
+    map.put(1, 100);
+    map.put(2, 200);
+    map.put(1, 500);
+
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ(map.get(1), 500);
+    EXPECT_EQ(map.get(2), 200);
+    EXPECT_THROW(map.get(3), std::runtime_error);
+}
+
+TEST(CuckooHashMapTest, RemoveExistingAndMissing) {
+    CuckooHashMap<int, int> map;
+
+    map.put(1, 100);
+    map.put(2, 200);
+
+    EXPECT_TRUE(map.remove(1));
+    EXPECT_FALSE(map.remove(1));
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(CuckooHashMapTest, MatchesReference) {
+    CuckooHashMap<int, int> map(8);
+    expectMatchesReference(map, 17, 50000, 5000, 3);
+    EXPECT_EQ(map.items().size(), map.size());
+}
+
+TEST(CuckooHashMapTest, HighLoadKeepsStashSmall) {
+    CuckooHashMap<int, int> map(1 << 14);
+    size_t cap = map.getCapacity();
+    int n = static_cast<int>(cap * 0.85);
+
+    for (int i = 0; i < n; i++) map.put(i * 7919, i);
+
+    // заполнение 85% без роста, stash не больше своего предела
+    EXPECT_EQ(map.getCapacity(), cap);
+    EXPECT_LE(map.stashSize(), 8u);
+    for (int i = 0; i < n; i++) ASSERT_EQ(map.get(i * 7919), i);
+}
+
+TEST(CuckooHashMapTest, DegenerateHashUsesStash) {
+    CuckooHashMap<int, int, ConstantHash> map;
+
+    for (int i = 0; i < 100; i++) map.put(i, i * 2);
+
+    EXPECT_EQ(map.size(), 100u);
+    EXPECT_GT(map.stashSize(), 0u);
+    for (int i = 0; i < 100; i++) ASSERT_EQ(map.get(i), i * 2);
+
+    // освобождённые ячейки корзин забирают элементы из stash
+    size_t stashed = map.stashSize();
+    for (int i = 0; i < 100; i += 2) EXPECT_TRUE(map.remove(i));
+    EXPECT_LT(map.stashSize(), stashed);
+    for (int i = 1; i < 100; i += 2) ASSERT_EQ(map.get(i), i * 2);
+}
+
+TEST(CuckooHashMapTest, ClearEmptiesMap) {
+    CuckooHashMap<int, int> map;
+    for (int i = 0; i < 100; i++) map.put(i, i);
+
+    map.clear();
+
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_FALSE(map.contains(5));
+    map.put(5, 50);
+    EXPECT_EQ(map.get(5), 50);
+}
+
+TEST(CuckooHashMapTest, DisplayOutputsData) {
+    CuckooHashMap<int, int> map;
+    map.put(1, 100);
+
+    std::stringstream buffer;
+    auto* old = std::cout.rdbuf(buffer.rdbuf());
+    map.display();
+    std::cout.rdbuf(old);
+
+    EXPECT_NE(buffer.str().find("1 : 100"), std::string::npos);
+}
+
+TEST(CuckooHashMapTest, JsonAndBinaryRoundTrip) {
+    CuckooHashMap<int, int> map;
+    for (int i = 0; i < 200; i++) map.put(i, i + 1);
+
+    nlohmann::json j;
+    map.to_json(j);
+    CuckooHashMap<int, int> fromJson;
+    fromJson.from_json(j);
+
+    std::stringstream ss;
+    map.to_binary(ss);
+    CuckooHashMap<int, int> fromBinary;
+    fromBinary.from_binary(ss);
+
+    EXPECT_EQ(fromJson.size(), 200u);
+    EXPECT_EQ(fromBinary.size(), 200u);
+    for (int i = 0; i < 200; i++) {
+        EXPECT_EQ(fromJson.get(i), i + 1);
+        EXPECT_EQ(fromBinary.get(i), i + 1);
+    }
+}
+
+// SET
+TEST(CuckooHashSetTest, PushContainsRemove) {
+    CuckooHashSet<int> set;
+    std::set<int> reference;
+    std::mt19937 rng(23);
+
+    for (int i = 0; i < 20000; i++) {
+        int key = static_cast<int>(rng() % 2000);
+        if (rng() % 2) {
+            set.push_back(key);
+            reference.insert(key);
+        } else {
+            EXPECT_EQ(set.remove(key), reference.erase(key) > 0);
+        }
+    }
+
+    EXPECT_EQ(set.size(), reference.size());
+    for (int key = 0; key < 2000; key++) {
+        ASSERT_EQ(set.contains(key), reference.count(key) > 0);
+    }
+}
+
+TEST(CuckooHashSetTest, JsonAndBinaryRoundTrip) {
+    CuckooHashSet<int> set;
+    for (int i = 0; i < 100; i++) set.push_back(i * 3);
+
+    nlohmann::json j;
+    set.to_json(j);
+    CuckooHashSet<int> fromJson;
+    fromJson.from_json(j);
+
+    std::stringstream ss;
+    set.to_binary(ss);
+    CuckooHashSet<int> fromBinary;
+    fromBinary.from_binary(ss);
+
+    EXPECT_EQ(fromJson.size(), 100u);
+    EXPECT_EQ(fromBinary.size(), 100u);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_TRUE(fromJson.contains(i * 3));
+        EXPECT_TRUE(fromBinary.contains(i * 3));
+        EXPECT_FALSE(fromBinary.contains(i * 3 + 1));
+    }
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <sstream>
 #include <type_traits>
+#include <vector>
 
 #include "../../json.hpp"
 
@@ -24,8 +25,8 @@ TYPED_TEST(DoubleHashingSetFullTest, ConstructorInitialState) {
     EXPECT_GT(this->set.getCapacity(), 0);
 }
 
-// hash1 / hash2 / probe
-TYPED_TEST(DoubleHashingSetFullTest, HashFunctionsAndProbe) {
+// probeStart
+TYPED_TEST(DoubleHashingSetFullTest, ProbeStartAndStep) {
     TypeParam key;
 
     if constexpr (std::is_integral_v<TypeParam>)
@@ -33,13 +34,20 @@ TYPED_TEST(DoubleHashingSetFullTest, HashFunctionsAndProbe) {
     else
         key = "test";
 
-    size_t h1 = this->set.hash1(key);
-    size_t h2 = this->set.hash2(key);
-    size_t p  = this->set.probe(key, 1);
+    size_t idx = 0, step = 0;
+    this->set.probeStart(key, idx, step);
 
-    EXPECT_LT(h1, this->set.capacity);
-    EXPECT_GE(h2, 1u);
-    EXPECT_LT(p, this->set.capacity);
+    EXPECT_LT(idx, this->set.capacity);
+    EXPECT_EQ(step % 2, 1u);  // нечётный шаг обходит всю таблицу-степень двойки
+    EXPECT_LT(step, this->set.capacity);
+    EXPECT_EQ(this->set.capacity & (this->set.capacity - 1), 0u);
+
+    // последовательность проб посещает каждую ячейку ровно один раз
+    std::vector<bool> seen(this->set.capacity, false);
+    for (size_t i = 0; i < this->set.capacity; i++, idx = (idx + step) & this->set.mask) {
+        EXPECT_FALSE(seen[idx]);
+        seen[idx] = true;
+    }
 }
 
 // INSERT / CONTAINS / DUPLICATES
@@ -91,6 +99,20 @@ TEST(DoubleHashingSetReuseTest, ReuseDeletedSlotInt) {
     EXPECT_FALSE(set.contains(1));
 }
 
+// NO DUPLICATE BEHIND DELETED SLOT
+TEST(DoubleHashingSetReuseTest, NoDuplicateAfterDeletedSlot) {
+    DoubleHashingSet<int> set(5);
+
+    set.push_back(1);
+    set.push_back(6);  // коллизия с 1
+    set.remove(1);
+    set.push_back(6);
+
+    EXPECT_EQ(set.size(), 1);
+    EXPECT_TRUE(set.remove(6));
+    EXPECT_FALSE(set.contains(6));
+}
+
 // RESIZE
 TEST(DoubleHashingSetResizeTest, ResizeTriggered) {
     DoubleHashingSet<int> set(3);
@@ -105,6 +127,17 @@ TEST(DoubleHashingSetResizeTest, ResizeTriggered) {
     EXPECT_TRUE(set.contains(4));
 }
 
+TEST(DoubleHashingSetResizeTest, GrowthKeepsAllKeysReachable) {
+    DoubleHashingSet<int> set;
+
+    for (int i = 0; i < 50000; ++i) set.push_back(i * 7);
+
+    EXPECT_EQ(set.size(), 50000);
+    EXPECT_TRUE(set.contains(0));
+    EXPECT_TRUE(set.contains(49999 * 7));
+    EXPECT_FALSE(set.contains(1));
+}
+
 // resize() PRIVATE
 TEST(DoubleHashingSetPrivateTest, ManualResize) {
     DoubleHashingSet<int> set(5);
@@ -114,11 +147,107 @@ TEST(DoubleHashingSetPrivateTest, ManualResize) {
 
     set.resize(20);
 
-    EXPECT_EQ(set.getCapacity(), 20);
+    EXPECT_EQ(set.getCapacity(), 32);  // округление до степени двойки
     EXPECT_TRUE(set.contains(1));
     EXPECT_TRUE(set.contains(2));
 }
 
+TEST(DoubleHashingSetPrivateTest, ResizeDropsDeletedAndKeepsKeys) {
+    DoubleHashingSet<std::string> set(8);
+    for (int i = 0; i < 5; ++i) set.push_back("k" + std::to_string(i));
+    set.remove("k1");
+    set.remove("k3");
+
+    set.resize(64);
+
+    EXPECT_EQ(set.size(), 3);
+    EXPECT_EQ(set.getCapacity(), 64);
+    EXPECT_TRUE(set.contains("k0"));
+    EXPECT_TRUE(set.contains("k4"));
+    EXPECT_FALSE(set.contains("k1"));
+    for (const auto& slot : set.table) {
+        EXPECT_NE(slot.status, DoubleHashingSet<std::string>::SlotStatus::DELETED);
+    }
+}
+
+TEST(DoubleHashingSetPrivateTest, DeletedTriggerRebuildsAtSameCapacity) {
+    DoubleHashingSet<int> set(64);
+    // занято 47 из 64 ячеек — чуть ниже порога 0.75, живых ключей два
+    for (int i = 0; i < 47; ++i) set.push_back(i);
+    for (int i = 0; i < 45; ++i) set.remove(i);
+    ASSERT_EQ(set.getCapacity(), 64);
+    ASSERT_EQ(set.deleted, 45u);
+
+    // живых ключей мало: порог задевают DELETED, и таблица пересобирается без роста
+    for (int k = 1000; set.deleted > 0 && k < 1100; ++k) set.push_back(k);
+
+    EXPECT_EQ(set.deleted, 0u);
+    EXPECT_EQ(set.getCapacity(), 64);
+    for (const auto& slot : set.table) {
+        EXPECT_NE(slot.status, DoubleHashingSet<int>::SlotStatus::DELETED);
+    }
+    EXPECT_TRUE(set.contains(45));
+    EXPECT_TRUE(set.contains(46));
+    EXPECT_FALSE(set.contains(0));
+}
+
+TEST(DoubleHashingSetPrivateTest, ChurnDoesNotFillTableWithDeleted) {
+    DoubleHashingSet<int> set;
+    const int window = 1000;
+    for (int i = 0; i < window; ++i) set.push_back(i);
+
+    // окно ключей сдвигается: вставка нового, удаление самого старого
+    for (int i = 0; i < 100000; ++i) {
+        set.push_back(i + window);
+        ASSERT_TRUE(set.remove(i));
+    }
+
+    size_t deletedSlots = 0, emptySlots = 0;
+    for (const auto& slot : set.table) {
+        if (slot.status == DoubleHashingSet<int>::SlotStatus::DELETED) deletedSlots++;
+        if (slot.status == DoubleHashingSet<int>::SlotStatus::EMPTY) emptySlots++;
+    }
+    EXPECT_EQ(set.deleted, deletedSlots);
+    EXPECT_EQ(set.size(), static_cast<size_t>(window));
+    EXPECT_LE(set.getCapacity(), 4096u);  // роста из-за одних DELETED нет
+    // не меньше четверти ячеек пусты: промах заканчивается за несколько проб
+    EXPECT_GE(emptySlots, set.getCapacity() / 4);
+    EXPECT_FALSE(set.contains(0));
+    EXPECT_TRUE(set.contains(100000 + window - 1));
+}
+
+TEST(DoubleHashingSetResizeTest, ReservePreventsGrowth) {
+    DoubleHashingSet<int> set;
+    set.reserve(10000);
+    size_t cap = set.getCapacity();
+
+    for (int i = 0; i < 10000; ++i) set.push_back(i);
+
+    EXPECT_EQ(set.getCapacity(), cap);
+    EXPECT_EQ(set.size(), 10000);
+
+    set.reserve(10);  // меньше текущей ёмкости — ничего не меняется
+    EXPECT_EQ(set.getCapacity(), cap);
+}
+
+// BATCH LOOKUP
+TEST(DoubleHashingSetBatchTest, ContainsBatchMatchesContains) {
+    DoubleHashingSet<int> set;
+    for (int i = 0; i < 700; ++i) set.push_back(i * 5);
+    for (int i = 0; i < 700; i += 3) set.remove(i * 5);
+
+    std::vector<int> keys;
+    for (int k = 0; k < 3501; ++k) keys.push_back(k);
+    bool* out = new bool[keys.size()];
+
+    set.contains_batch(keys.data(), keys.size(), out);
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_EQ(out[i], set.contains(keys[i])) << keys[i];
+    }
+    delete[] out;
+}
+
 // OVERFLOW ERROR
 // TEST(DoubleHashingSetEdgeTest, OverflowThrows) {
 //     DoubleHashingSet<int> set(3);
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <cctype>
+
+#include "HashFunctions.hpp"
+#include "SeparateChainingHashTable.hpp"
+#include "LinearProbingHashTable.hpp"
+#include "DoubleHashingHashTable.hpp"
+
+// Сравнение строк без учёта регистра — для проверки параметров Hash/KeyEqual
+struct CaseInsensitiveHash {
+    size_t operator()(const std::string& s) const {
+        std::string lower = s;
+        for (auto& c : lower) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        return FastHash<std::string>{}(lower);
+    }
+};
+
+struct CaseInsensitiveEqual {
+    bool operator()(const std::string& a, const std::string& b) const {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); i++) {
+            if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) return false;
+        }
+        return true;
+    }
+};
+
+// FASTHASH
+TEST(HashFunctionsTest, SequentialIntsSpreadOverBuckets) {
+    // последовательные ключи не должны занимать соседние корзины
+    const size_t buckets = 1024;
+    std::vector<int> load(buckets, 0);
+    for (int i = 0; i < 1024; i++) load[FastHash<int>{}(i) % buckets]++;
+
+    int used = 0;
+    for (int x : load) used += x > 0;
+    EXPECT_GT(used, 550);  // при случайном хэше ожидается около 647
+}
+
+TEST(HashFunctionsTest, StridedIntsSpreadOverPowerOfTwoBuckets) {
+    const size_t buckets = 256;
+    std::unordered_set<size_t> used;
+    for (int i = 0; i < 256; i++) used.insert(FastHash<int>{}(i * 1024) % buckets);
+    EXPECT_GT(used.size(), 130u);
+}
+
+TEST(HashFunctionsTest, StringsOfAllLengthsDiffer) {
+    std::unordered_set<size_t> seen;
+    std::string s;
+    for (int len = 0; len < 100; len++) {
+        seen.insert(FastHash<std::string>{}(s));
+        s.push_back('a');
+    }
+    EXPECT_EQ(seen.size(), 100u);
+
+    EXPECT_NE(FastHash<std::string>{}("abc"), FastHash<std::string>{}("acb"));
+    EXPECT_EQ(FastHash<std::string>{}("hello"), FastHash<std::string_view>{}("hello"));
+}
+
+// СТЕПЕНИ ДВОЙКИ
+TEST(HashFunctionsTest, RoundUpPow2) {
+    EXPECT_EQ(hashing::roundUpPow2(0), 2u);
+    EXPECT_EQ(hashing::roundUpPow2(3), 4u);
+    EXPECT_EQ(hashing::roundUpPow2(16), 16u);
+    EXPECT_EQ(hashing::roundUpPow2(17), 32u);
+    EXPECT_EQ(hashing::log2Pow2(1024), 10u);
+}
+
+TEST(HashFunctionsTest, FibonacciIndexSpreadsIdentityHash) {
+    const unsigned bits = 8;
+    std::unordered_set<size_t> sequential, strided;
+    for (size_t k = 0; k < 256; k++) {
+        size_t idx = hashing::fibonacciIndex(k, bits);
+        EXPECT_LT(idx, 256u);
+        sequential.insert(idx);
+        // с маской & 255 все такие ключи попали бы в ячейку 0
+        strided.insert(hashing::fibonacciIndex(k * 256, bits));
+    }
+    EXPECT_GT(sequential.size(), 200u);
+    EXPECT_GT(strided.size(), 128u);
+}
+
+// ПОЛЬЗОВАТЕЛЬСКИЕ Hash / KeyEqual
+TEST(HashFunctionsTest, SeparateChainingUsesCustomEquality) {
+    SeparateChainingHashMap<std::string, int, CaseInsensitiveHash, CaseInsensitiveEqual> map;
+
+    map.put("Key", 1);
+    map.put("KEY", 2);
+
+    EXPECT_TRUE(map.contains("key"));
+    EXPECT_EQ(map.get("kEy"), 2);
+    EXPECT_EQ(map.items().size(), 1u);
+}
+
+TEST(HashFunctionsTest, LinearProbingUsesCustomEquality) {
+    LinearProbingHashMap<std::string, int, CaseInsensitiveHash, CaseInsensitiveEqual> map;
+
+    map.put("Key", 1);
+    map.put("KEY", 2);
+
+    EXPECT_EQ(map.size(), 1u);
+    EXPECT_EQ(map.get("key"), 2);
+    EXPECT_TRUE(map.remove("kEY"));
+    EXPECT_TRUE(map.isEmpty());
+}
+
+TEST(HashFunctionsTest, DoubleHashingUsesCustomEquality) {
+    DoubleHashingSet<std::string, CaseInsensitiveHash, CaseInsensitiveEqual> set;
+
+    set.push_back("Key");
+    set.push_back("KEY");
+
+    EXPECT_EQ(set.size(), 1u);
+    EXPECT_TRUE(set.contains("key"));
+}
+
+TEST(HashFunctionsTest, StringKeysInSeparateChaining) {
+    SeparateChainingHashMap<std::string, int> map;
+    for (int i = 0; i < 1000; i++) map.put("key" + std::to_string(i), i);
+    for (int i = 0; i < 1000; i++) EXPECT_EQ(map.get("key" + std::to_string(i)), i);
+}
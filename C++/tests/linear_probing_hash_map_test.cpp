@@ -1,9 +1,22 @@
 #include <gtest/gtest.h>
 #include <sstream>
+#include <memory>
+#include <vector>
 
 #include "LinearProbingHashTable.hpp"
+#include "map_reference_check.hpp"
 #include "../../json.hpp"
 
+// Первые count ключей, чья домашняя ячейка в таблице ёмкости capacity равна home
+static std::vector<int> keysWithHome(size_t home, size_t capacity, int count) {
+    std::vector<int> keys;
+    unsigned bits = hashing::log2Pow2(capacity);
+    for (int k = 0; static_cast<int>(keys.size()) < count; k++) {
+        if (hashing::fibonacciIndex(FastHash<int>{}(k), bits) == home) keys.push_back(k);
+    }
+    return keys;
+}
+
 // БАЗОВОЕ СОСТОЯНИЕ
 TEST(LinearProbingHashMapTest, EmptyOnCreation) {
     LinearProbingHashMap<int, int> map;
@@ -80,13 +93,14 @@ TEST(LinearProbingHashMapTest, SizeAndIsEmptyWorkCorrectly) {
 
 // COLLISIONS (LINEAR PROBING)
 TEST(LinearProbingHashMapTest, HandlesCollisions) {
-    LinearProbingHashMap<int, int> map(5);
+    LinearProbingHashMap<int, int> map(8);
+    std::vector<int> keys = keysWithHome(1, 8, 2);  // коллизия: обе в ячейке 1
 
-    map.put(1, 100);
-    map.put(6, 600);  // коллизия: 1 % 5 == 6 % 5
+    map.put(keys[0], 100);
+    map.put(keys[1], 600);
 
-    EXPECT_EQ(map.get(1), 100);
-    EXPECT_EQ(map.get(6), 600);
+    EXPECT_EQ(map.get(keys[0]), 100);
+    EXPECT_EQ(map.get(keys[1]), 600);
 }
 
 // DELETED SLOT REUSE
@@ -103,15 +117,159 @@ TEST(LinearProbingHashMapTest, RemoveAndReinsertUsesDeletedSlot) {
     EXPECT_EQ(map.get(1), 200);
 }
 
-// TABLE FULL
-TEST(LinearProbingHashMapTest, ThrowsWhenTableIsFull) {
+// GROWTH
+TEST(LinearProbingHashMapTest, GrowsWhenLoadFactorExceeded) {
     LinearProbingHashMap<int, int> map(3);
 
+    for (int i = 0; i < 1000; i++) {
+        map.put(i, i * 10);
+    }
+
+    EXPECT_EQ(map.size(), 1000u);
+    EXPECT_GE(map.getCapacity(), 1000u);
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(map.get(i), i * 10);
+    }
+}
+
+// TOMBSTONES
+TEST(LinearProbingHashMapTest, ChurnDoesNotGrowTable) {
+    LinearProbingHashMap<int, int> map(64, DeletionMode::TOMBSTONE);
+
+    // живых ключей всегда не больше 10, остальное место занимают DELETED
+    for (int i = 0; i < 10000; i++) {
+        map.put(i, i);
+        if (i >= 10) {
+            EXPECT_TRUE(map.remove(i - 10));
+        }
+    }
+
+    EXPECT_EQ(map.size(), 10u);
+    EXPECT_EQ(map.getCapacity(), 64u);
+    for (int i = 9990; i < 10000; i++) {
+        EXPECT_EQ(map.get(i), i);
+    }
+    EXPECT_FALSE(map.contains(0));
+}
+
+TEST(LinearProbingHashMapTest, NoDuplicateAfterDeletedSlot) {
+    LinearProbingHashMap<int, int> map(16, DeletionMode::TOMBSTONE);
+    std::vector<int> keys = keysWithHome(3, 16, 2);
+
+    map.put(keys[0], 10);
+    map.put(keys[1], 110);  // коллизия: стоит после keys[0]
+    map.remove(keys[0]);
+
+    map.put(keys[1], 111);  // обновление, а не вторая копия в ячейке 3
+    EXPECT_EQ(map.size(), 1u);
+    EXPECT_TRUE(map.remove(keys[1]));
+    EXPECT_FALSE(map.contains(keys[1]));
+}
+
+// BACKWARD SHIFT
+TEST(LinearProbingHashMapTest, BackwardShiftKeepsWrappedClusterReachable) {
+    LinearProbingHashMap<int, int> map(32);
+    std::vector<int> a = keysWithHome(30, 32, 3);
+    int b = keysWithHome(31, 32, 1)[0];
+    int c = keysWithHome(0, 32, 1)[0];
+
+    // ячейки 30, 31, 0, 1, 2: кластер переходит через конец таблицы
+    map.put(a[0], 1);
+    map.put(a[1], 2);
+    map.put(b, 3);
+    map.put(a[2], 4);
+    map.put(c, 5);
+
+    EXPECT_TRUE(map.remove(a[0]));
+    EXPECT_EQ(map.get(a[1]), 2);
+    EXPECT_EQ(map.get(b), 3);
+    EXPECT_EQ(map.get(a[2]), 4);
+    EXPECT_EQ(map.get(c), 5);
+
+    EXPECT_TRUE(map.remove(b));
+    EXPECT_EQ(map.get(a[2]), 4);
+    EXPECT_EQ(map.get(c), 5);
+    EXPECT_EQ(map.size(), 3u);
+    EXPECT_EQ(map.maxProbeLength(), 1u);
+}
+
+TEST(LinearProbingHashMapTest, BackwardShiftMatchesReference) {
+    LinearProbingHashMap<int, int> map(8);
+    expectMatchesReference(map, 7, 20000, 300, 2);
+}
+
+TEST(LinearProbingHashMapTest, ProbeLengthStaysBoundedUnderChurn) {
+    LinearProbingHashMap<int, int> map(1024);
+    for (int i = 0; i < 500; i++) map.put(i * 7, i);
+
+    size_t initial = map.maxProbeLength();
+    for (int i = 500; i < 200000; i++) {
+        map.put(i * 7, i);
+        map.remove((i - 500) * 7);
+    }
+
+    EXPECT_EQ(map.size(), 500u);
+    EXPECT_EQ(map.getCapacity(), 1024u);
+    EXPECT_LE(map.maxProbeLength(), initial + 16);
+}
+
+// BATCH LOOKUP
+TEST(LinearProbingHashMapTest, BatchLookupMatchesSingleKey) {
+    for (DeletionMode mode : {DeletionMode::TOMBSTONE, DeletionMode::BACKWARD_SHIFT}) {
+        LinearProbingHashMap<int, int> map(8, mode);
+        for (int i = 0; i < 600; i++) map.put(i * 3, i);
+        for (int i = 0; i < 600; i += 4) map.remove(i * 3);
+
+        // длина не кратна размеру куска, половина ключей отсутствует
+        std::vector<int> keys;
+        for (int k = 0; k < 1803; k++) keys.push_back(k);
+        std::unique_ptr<bool[]> present(new bool[keys.size()]), found(new bool[keys.size()]);
+        std::vector<int> values(keys.size(), -1);
+
+        map.contains_batch(keys.data(), keys.size(), present.get());
+        map.get_batch(keys.data(), keys.size(), values.data(), found.get());
+
+        for (size_t i = 0; i < keys.size(); i++) {
+            ASSERT_EQ(present[i], map.contains(keys[i]));
+            ASSERT_EQ(present[i], found[i]);
+            if (found[i]) {
+                EXPECT_EQ(values[i], map.get(keys[i]));
+            } else {
+                EXPECT_EQ(values[i], -1);
+            }
+        }
+    }
+}
+
+// BINARY SERIALIZATION
+TEST(LinearProbingHashMapTest, BinaryRoundTripKeepsSize) {
+    LinearProbingHashMap<int, int> map;
+    for (int i = 0; i < 50; i++) map.put(i, i);
+
+    stringstream ss;
+    map.to_binary(ss);
+
+    LinearProbingHashMap<int, int> restored;
+    restored.from_binary(ss);
+
+    EXPECT_EQ(restored.size(), 50u);
+    EXPECT_EQ(restored.get(49), 49);
+}
+
+// CLEAR
+TEST(LinearProbingHashMapTest, ClearEmptiesMap) {
+    LinearProbingHashMap<int, int> map;
+
     map.put(1, 10);
     map.put(2, 20);
-    map.put(3, 30);
 
-    EXPECT_THROW(map.put(4, 40), std::runtime_error);
+    map.clear();
+
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_FALSE(map.contains(1));
+
+    map.put(1, 30);
+    EXPECT_EQ(map.get(1), 30);
 }
 
 // DISPLAY (cout)
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <climits>
+#include <cstdint>
+#include <set>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <vector>
+
+#include "LockFreeHashTable.hpp"
+#include "../../json.hpp"
+
+// БАЗОВЫЕ ОПЕРАЦИИ
+TEST(LockFreeHashSetTest, InsertContainsRemove) {
+    LockFreeHashSet<int> set(100);
+
+    set.push_back(5);
+    set.push_back(5);
+    set.push_back(-7);
+
+    EXPECT_EQ(set.size(), 2u);
+    EXPECT_TRUE(set.contains(5));
+    EXPECT_TRUE(set.contains(-7));
+    EXPECT_FALSE(set.contains(7));
+
+    EXPECT_TRUE(set.remove(5));
+    EXPECT_FALSE(set.remove(5));
+    EXPECT_FALSE(set.contains(5));
+    EXPECT_EQ(set.size(), 1u);
+}
+
+TEST(LockFreeHashSetTest, ExtremeKeysDoNotCollideWithState) {
+    LockFreeHashSet<int> set(16);
+    set.push_back(0);
+    set.push_back(INT_MIN);
+    set.push_back(INT_MAX);
+    set.push_back(-1);
+
+    EXPECT_EQ(set.size(), 4u);
+    for (int key : {0, INT_MIN, INT_MAX, -1}) EXPECT_TRUE(set.contains(key));
+    EXPECT_FALSE(set.contains(1));
+
+    LockFreeHashSet<uint16_t> small(16);
+    small.push_back(65535);
+    EXPECT_TRUE(small.contains(65535));
+    EXPECT_FALSE(small.contains(0));
+}
+
+// TOMBSTONES
+TEST(LockFreeHashSetTest, ReinsertRevivesOwnSlot) {
+    LockFreeHashSet<int> set(8);
+    size_t capacity = set.getCapacity();
+
+    // тот же набор ключей много раз: новые ячейки не занимаются
+    for (int round = 0; round < 1000; round++) {
+        for (int k = 0; k < 8; k++) set.push_back(k);
+        for (int k = 0; k < 8; k += 2) EXPECT_TRUE(set.remove(k));
+    }
+
+    EXPECT_EQ(set.getCapacity(), capacity);
+    EXPECT_EQ(set.size(), 4u);
+    EXPECT_TRUE(set.contains(1));
+    EXPECT_FALSE(set.contains(2));
+}
+
+TEST(LockFreeHashSetTest, ThrowsWhenDistinctKeysExceedCapacity) {
+    LockFreeHashSet<int> set(10);
+    for (int k = 0; k < 10; k++) set.push_back(k);
+
+    // удалённые ключи продолжают занимать ячейки
+    for (int k = 0; k < 10; k++) set.remove(k);
+    EXPECT_THROW(for (int k = 10; k < 1000; k++) set.push_back(k), std::overflow_error);
+
+    set.clear();
+    EXPECT_EQ(set.size(), 0u);
+    for (int k = 100; k < 110; k++) set.push_back(k);
+    EXPECT_EQ(set.size(), 10u);
+}
+
+// НЕСКОЛЬКО ПОТОКОВ
+TEST(LockFreeHashSetTest, ConcurrentInsertsOfSameKeysLeaveOneCopy) {
+    const int threads = 4;
+    const int keys = 20000;
+    LockFreeHashSet<int> set(keys);
+    std::vector<std::thread> pool;
+
+    // все потоки вставляют одни и те же ключи в разном порядке
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&, t]() {
+            for (int i = 0; i < keys; i++) set.push_back((i * (2 * t + 1)) % keys);
+        });
+    }
+    for (auto& th : pool) th.join();
+
+    EXPECT_EQ(set.size(), static_cast<size_t>(keys));
+    // после одного remove ключа не остаётся: второй копии нет
+    for (int k = 0; k < keys; k++) ASSERT_TRUE(set.remove(k));
+    for (int k = 0; k < keys; k++) ASSERT_FALSE(set.contains(k));
+    EXPECT_EQ(set.size(), 0u);
+}
+
+TEST(LockFreeHashSetTest, StressMixedOperations) {
+    const int writers = 3;
+    const int perWriter = 4000;
+    const int stable = 1000;
+    LockFreeHashSet<int> set(stable + writers * perWriter);
+    for (int k = 0; k < stable; k++) set.push_back(-1 - k);
+
+    std::atomic<int> running{writers};
+    std::atomic<int> readerMisses{0};
+    std::vector<std::set<int>> expected(writers);
+    std::vector<std::thread> pool;
+
+    // писатель t работает с ключами t, t + writers, ...; у него точный эталон
+    for (int t = 0; t < writers; t++) {
+        pool.emplace_back([&, t]() {
+            std::mt19937 rng(t + 1);
+            for (int i = 0; i < 60000; i++) {
+                int key = static_cast<int>(rng() % perWriter) * writers + t;
+                switch (rng() % 3) {
+                    case 0:
+                        set.push_back(key);
+                        expected[t].insert(key);
+                        break;
+                    case 1:
+                        EXPECT_EQ(set.remove(key), expected[t].erase(key) > 0);
+                        break;
+                    default:
+                        EXPECT_EQ(set.contains(key), expected[t].count(key) > 0);
+                }
+            }
+            running--;
+        });
+    }
+    // читатели: отрицательные ключи никто не удаляет
+    for (int r = 0; r < 2; r++) {
+        pool.emplace_back([&, r]() {
+            for (int i = r; running.load() > 0 || i < stable; i++) {
+                if (!set.contains(-1 - i % stable)) readerMisses++;
+            }
+        });
+    }
+    for (auto& th : pool) th.join();
+
+    EXPECT_EQ(readerMisses.load(), 0);
+    size_t total = stable;
+    for (int t = 0; t < writers; t++) {
+        total += expected[t].size();
+        for (int key = t; key < perWriter * writers; key += writers) {
+            ASSERT_EQ(set.contains(key), expected[t].count(key) > 0);
+        }
+    }
+    EXPECT_EQ(set.size(), total);
+}
+
+// SERIALIZATION
+TEST(LockFreeHashSetTest, JsonAndBinaryRoundTrip) {
+    LockFreeHashSet<int> set(200);
+    for (int k = 0; k < 150; k++) set.push_back(k * 3);
+    set.remove(0);
+
+    nlohmann::json j;
+    set.to_json(j);
+    LockFreeHashSet<int> fromJson;
+    fromJson.from_json(j);
+
+    std::stringstream ss;
+    set.to_binary(ss);
+    LockFreeHashSet<int> fromBinary;
+    fromBinary.from_binary(ss);
+
+    EXPECT_EQ(fromJson.size(), 149u);
+    EXPECT_EQ(fromBinary.size(), 149u);
+    EXPECT_EQ(fromJson.getCapacity(), set.getCapacity());
+    EXPECT_FALSE(fromBinary.contains(0));
+    for (int k = 1; k < 150; k++) {
+        EXPECT_TRUE(fromJson.contains(k * 3));
+        EXPECT_TRUE(fromBinary.contains(k * 3));
+    }
+}
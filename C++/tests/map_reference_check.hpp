@@ -0,0 +1,42 @@
+#pragma once
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <type_traits>
+
+// Общая проверка словарей против std::map: ops случайных операций над
+// ключами из [0, keyRange) выполняются на обоих, затем сверяется каждый ключ.
+// Операция — put, если rng() % putOdds != 0, иначе remove; значение для
+// i-й операции — makeValue(i). remove может возвращать bool или void
+template<typename Map, typename MakeValue>
+void expectMatchesReference(Map& map, unsigned seed, int ops, int keyRange, unsigned putOdds,
+                            MakeValue makeValue) {
+    std::map<int, decltype(makeValue(0))> reference;
+    std::mt19937 rng(seed);
+
+    for (int i = 0; i < ops; i++) {
+        int key = static_cast<int>(rng() % static_cast<unsigned>(keyRange));
+        if (rng() % putOdds) {
+            map.put(key, makeValue(i));
+            reference[key] = makeValue(i);
+        } else if constexpr (std::is_same_v<decltype(map.remove(key)), bool>) {
+            EXPECT_EQ(map.remove(key), reference.erase(key) > 0);
+        } else {
+            map.remove(key);
+            reference.erase(key);
+        }
+    }
+
+    EXPECT_EQ(map.size(), reference.size());
+    for (int key = 0; key < keyRange; key++) {
+        ASSERT_EQ(map.contains(key), reference.count(key) > 0) << key;
+        if (reference.count(key)) {
+            EXPECT_EQ(map.get(key), reference[key]) << key;
+        }
+    }
+}
+
+template<typename Map>
+void expectMatchesReference(Map& map, unsigned seed, int ops, int keyRange, unsigned putOdds) {
+    expectMatchesReference(map, seed, ops, keyRange, putOdds, [](int i) { return i; });
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "NodePool.hpp"
+#include "SeparateChainingHashTable.hpp"
+
+struct PoolItem {
+    int a;
+    std::string s;
+    PoolItem(int a_, std::string s_) : a(a_), s(std::move(s_)) {}
+};
+
+TEST(NodePoolTest, CreateConstructsInPlace) {
+    NodePool<PoolItem> pool;
+    PoolItem* x = pool.create(7, "seven");
+
+    EXPECT_EQ(x->a, 7);
+    EXPECT_EQ(x->s, "seven");
+    EXPECT_EQ(pool.liveNodes(), 1u);
+    pool.destroy(x);
+    EXPECT_EQ(pool.liveNodes(), 0u);
+}
+
+TEST(NodePoolTest, DestroyedSlotIsReusedFirst) {
+    NodePool<PoolItem> pool;
+    PoolItem* a = pool.create(1, "a");
+    pool.create(2, "b");
+
+    pool.destroy(a);
+    PoolItem* c = pool.create(3, "c");
+    EXPECT_EQ(c, a);
+}
+
+TEST(NodePoolTest, ResetKeepsMemoryReleaseFreesIt) {
+    NodePool<int> pool;
+    for (int i = 0; i < 1000; i++) pool.create(i);
+    EXPECT_GE(pool.reservedNodes(), 1000u);
+
+    pool.reset();
+    EXPECT_EQ(pool.liveNodes(), 0u);
+    EXPECT_GT(pool.reservedNodes(), 0u);
+
+    pool.release();
+    EXPECT_EQ(pool.reservedNodes(), 0u);
+}
+
+TEST(NodePoolTest, SeparateChainingReusesAfterClear) {
+    SeparateChainingHashMap<int, std::string> map;
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 5000; i++) map.put(i, std::to_string(i));
+        for (int i = 0; i < 5000; i += 2) map.remove(i);
+        EXPECT_EQ(map.items().size(), 2500u);
+        EXPECT_EQ(map.get(4999), "4999");
+        map.clear(round == 1);
+        EXPECT_TRUE(map.empty());
+    }
+}
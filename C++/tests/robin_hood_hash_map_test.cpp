@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+
+#include "RobinHoodHashTable.hpp"
+#include "map_reference_check.hpp"
+#include "../../json.hpp"
+
+// Первые count ключей, чья домашняя ячейка в таблице ёмкости capacity равна home
+static std::vector<int> keysWithHome(size_t home, size_t capacity, int count) {
+    std::vector<int> keys;
+    unsigned bits = hashing::log2Pow2(capacity);
+    for (int k = 0; static_cast<int>(keys.size()) < count; k++) {
+        if (hashing::fibonacciIndex(FastHash<int>{}(k), bits) == home) keys.push_back(k);
+    }
+    return keys;
+}
+
+// БАЗОВОЕ СОСТОЯНИЕ
+TEST(RobinHoodHashMapTest, EmptyOnCreation) {
+    RobinHoodHashMap<int, int> map;
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_EQ(map.size(), 0u);
+}
+
+// PUT / CONTAINS / GET
+TEST(RobinHoodHashMapTest, PutAndGet) {
+    RobinHoodHashMap<int, int> map;
+
+    map.put(1, 100);
+    map.put(2, 200);
+
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_TRUE(map.contains(1));
+    EXPECT_TRUE(map.contains(2));
+    EXPECT_EQ(map.get(1), 100);
+    EXPECT_EQ(map.get(2), 200);
+}
+
+TEST(RobinHoodHashMapTest, PutUpdatesValue) {
+    RobinHoodHashMap<int, int> map;
+
+    map.put(1, 100);
+    map.put(1, 500);
+
+    EXPECT_EQ(map.size(), 1u);
+    EXPECT_EQ(map.get(1), 500);
+}
+
+// REMOVE
+TEST(RobinHoodHashMapTest, RemoveExistingKey) {
+    RobinHoodHashMap<int, int> map;
+
+    map.put(1, 100);
+    map.put(2, 200);
+
+    EXPECT_TRUE(map.remove(1));
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(RobinHoodHashMapTest, RemoveNonExistingKey) {
+    RobinHoodHashMap<int, int> map;
+
+    map.put(1, 100);
+    EXPECT_FALSE(map.remove(999));
+    EXPECT_EQ(map.size(), 1u);
+}
+
+// GET EXCEPTIONS
+TEST(RobinHoodHashMapTest, GetThrowsWhenNotFound) {
+    RobinHoodHashMap<int, int> map;
+
+    map.put(1, 100);
+    EXPECT_THROW(map.get(2), std::runtime_error);
+}
+
+// COLLISIONS
+TEST(RobinHoodHashMapTest, RicherKeyGivesUpSlot) {
+    RobinHoodHashMap<int, int> map(16);
+    std::vector<int> a = keysWithHome(1, 16, 2);
+    int b = keysWithHome(2, 16, 1)[0];
+
+    map.put(a[0], 10);
+    map.put(b, 20);      // ячейка 2
+    map.put(a[1], 110);  // домашняя 1, вытесняет b из ячейки 2
+
+    EXPECT_EQ(map.get(a[0]), 10);
+    EXPECT_EQ(map.get(b), 20);
+    EXPECT_EQ(map.get(a[1]), 110);
+    EXPECT_EQ(map.maxProbeLength(), 1u);
+}
+
+TEST(RobinHoodHashMapTest, RemoveShiftsWrappedCluster) {
+    RobinHoodHashMap<int, int> map(32);
+    std::vector<int> a = keysWithHome(30, 32, 4);
+    int b = keysWithHome(31, 32, 1)[0];
+
+    // ячейки 30, 31, 0, 1: кластер переходит через конец таблицы
+    map.put(a[0], 1);
+    map.put(a[1], 2);
+    map.put(a[2], 3);
+    map.put(b, 4);
+
+    EXPECT_TRUE(map.remove(a[0]));
+    EXPECT_EQ(map.get(a[1]), 2);
+    EXPECT_EQ(map.get(a[2]), 3);
+    EXPECT_EQ(map.get(b), 4);
+    EXPECT_FALSE(map.contains(a[3]));
+    EXPECT_EQ(map.size(), 3u);
+}
+
+// GROWTH
+TEST(RobinHoodHashMapTest, GrowsWhenLoadFactorExceeded) {
+    RobinHoodHashMap<int, int> map(3);
+
+    for (int i = 0; i < 1000; i++) {
+        map.put(i, i * 10);
+    }
+
+    EXPECT_EQ(map.size(), 1000u);
+    EXPECT_GE(map.getCapacity(), 1000u);
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(map.get(i), i * 10);
+    }
+}
+
+TEST(RobinHoodHashMapTest, MatchesReference) {
+    RobinHoodHashMap<int, int> map(8);
+    expectMatchesReference(map, 11, 20000, 500, 3);
+}
+
+// CLEAR
+TEST(RobinHoodHashMapTest, ClearEmptiesMap) {
+    RobinHoodHashMap<int, int> map;
+
+    map.put(1, 10);
+    map.put(2, 20);
+
+    map.clear();
+
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_FALSE(map.contains(1));
+
+    map.put(1, 30);
+    EXPECT_EQ(map.get(1), 30);
+}
+
+// DISPLAY (cout)
+TEST(RobinHoodHashMapTest, DisplayOutputsData) {
+    RobinHoodHashMap<int, int> map;
+    map.put(1, 100);
+    map.put(2, 200);
+
+    std::stringstream buffer;
+    auto* old = std::cout.rdbuf(buffer.rdbuf());
+
+    map.display();
+
+    std::cout.rdbuf(old);
+
+    std::string output = buffer.str();
+    EXPECT_NE(output.find("1 : 100"), std::string::npos);
+    EXPECT_NE(output.find("2 : 200"), std::string::npos);
+}
+
+// JSON SERIALIZATION
+TEST(RobinHoodHashMapTest, JsonSerializeDeserialize) {
+    RobinHoodHashMap<int, int> map;
+
+    map.put(1, 100);
+    map.put(2, 200);
+    map.put(3, 300);
+
+    nlohmann::json j;
+    map.to_json(j);
+
+    RobinHoodHashMap<int, int> restored;
+    restored.from_json(j);
+
+    EXPECT_EQ(restored.size(), 3u);
+    EXPECT_EQ(restored.get(1), 100);
+    EXPECT_EQ(restored.get(2), 200);
+    EXPECT_EQ(restored.get(3), 300);
+}
+
+// BINARY SERIALIZATION
+TEST(RobinHoodHashMapTest, BinarySerializeDeserialize) {
+    RobinHoodHashMap<int, int> map;
+    for (int i = 0; i < 50; i++) map.put(i, i + 1);
+
+    std::stringstream ss;
+    map.to_binary(ss);
+
+    RobinHoodHashMap<int, int> restored;
+    restored.from_binary(ss);
+
+    EXPECT_EQ(restored.size(), 50u);
+    for (int i = 0; i < 50; i++) {
+        EXPECT_EQ(restored.get(i), i + 1);
+    }
+}
@@ -1,9 +1,19 @@
 #include <gtest/gtest.h>
 #include <sstream>
+#include <map>
+#include <random>
+#include <vector>
+#include <memory>
 
 #include "SeparateChainingHashTable.hpp"
+#include "map_reference_check.hpp"
 #include "../../json.hpp"
 
+// Все ключи в одной корзине
+struct ZeroHash {
+    size_t operator()(int) const { return 0; }
+};
+
 // BASIC STATE
 TEST(SeparateChainingHashMapTest, EmptyOnCreation) {
     SeparateChainingHashMap<int, int> map;
@@ -71,15 +81,22 @@ TEST(SeparateChainingHashMapTest, GetThrowsIfKeyNotFound) {
 
 // COLLISIONS (SEPARATE CHAINING)
 TEST(SeparateChainingHashMapTest, HandlesCollisions) {
-    SeparateChainingHashMap<int, int> map(3);
+    SeparateChainingHashMap<int, int, ZeroHash> map(4);
 
     map.put(1, 100);
-    map.put(4, 400); // гарантированная коллизия при capacity=3
+    map.put(4, 400); // гарантированная коллизия: хэш всегда 0
 
     EXPECT_EQ(map.get(1), 100);
     EXPECT_EQ(map.get(4), 400);
 }
 
+TEST(SeparateChainingHashMapTest, OverflowChainRefillsInlineSlots) {
+    // все ключи в одной корзине: сначала встроенные ячейки, затем цепочка
+    SeparateChainingHashMap<int, std::string, ZeroHash> map(1024);
+    expectMatchesReference(map, 3, 3000, 40, 2, [](int i) { return std::to_string(i); });
+    EXPECT_EQ(map.items().size(), map.size());
+}
+
 // REHASH
 TEST(SeparateChainingHashMapTest, RehashTriggeredByLoadFactor) {
     SeparateChainingHashMap<int, int> map(3);
@@ -93,6 +110,142 @@ TEST(SeparateChainingHashMapTest, RehashTriggeredByLoadFactor) {
     EXPECT_EQ(map.get(3), 30);
 }
 
+TEST(SeparateChainingHashMapTest, IncrementalRehashMatchesReference) {
+    SeparateChainingHashMap<int, int> map(4, RehashMode::INCREMENTAL);
+    std::map<int, int> reference;
+    std::mt19937 rng(5);
+    bool sawRehashing = false;
+
+    for (int i = 0; i < 20000; i++) {
+        int key = static_cast<int>(rng() % 3000);
+        if (rng() % 4) {
+            map.put(key, i);
+            reference[key] = i;
+        } else {
+            map.remove(key);
+            reference.erase(key);
+        }
+        sawRehashing |= map.isRehashing();
+
+        // проверка на каждом шаге, пока часть ключей в старой таблице
+        if (map.isRehashing()) {
+            int probe = static_cast<int>(rng() % 3000);
+            ASSERT_EQ(map.contains(probe), reference.count(probe) > 0);
+        }
+    }
+
+    EXPECT_TRUE(sawRehashing);
+    EXPECT_EQ(map.items().size(), reference.size());
+    for (const auto& [key, value] : reference) {
+        ASSERT_TRUE(map.contains(key));
+        EXPECT_EQ(map.get(key), value);
+    }
+}
+
+TEST(SeparateChainingHashMapTest, IncrementalRehashCopyAndSerializeMidMigration) {
+    SeparateChainingHashMap<int, int> map(4, RehashMode::INCREMENTAL);
+    int n = 0;
+    while (!map.isRehashing()) {
+        map.put(n, n * 2);
+        n++;
+    }
+    for (int i = 0; i < 40 || !map.isRehashing(); i++) {
+        map.put(n, n * 2);
+        n++;
+    }
+    ASSERT_TRUE(map.isRehashing());
+
+    SeparateChainingHashMap<int, int> copy(map);
+    SeparateChainingHashMap<int, int> assigned;
+    assigned = map;
+
+    nlohmann::json j;
+    map.to_json(j);
+    SeparateChainingHashMap<int, int> restored;
+    restored.from_json(j);
+
+    EXPECT_EQ(map.items().size(), static_cast<size_t>(n));
+    EXPECT_EQ(j["items"].size(), static_cast<size_t>(n));
+    for (int k = 0; k < n; k++) {
+        EXPECT_EQ(copy.get(k), k * 2);
+        EXPECT_EQ(assigned.get(k), k * 2);
+        EXPECT_EQ(restored.get(k), k * 2);
+    }
+
+    // копия продолжает перенос независимо от оригинала
+    for (int k = 0; k < n; k++) copy.remove(k);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(map.get(0), 0);
+}
+
+TEST(SeparateChainingHashMapTest, GetKeepsReferencesDuringMigration) {
+    SeparateChainingHashMap<int, int> map(4, RehashMode::INCREMENTAL);
+    int n = 0;
+    while (!map.isRehashing()) {
+        map.put(n, n);
+        n++;
+    }
+
+    std::vector<int*> refs;
+    for (int k = 0; k < n; k++) refs.push_back(&map.get(k));
+    for (int k = n - 1; k >= 0; k--) EXPECT_EQ(&map.get(k), refs[k]);
+
+    EXPECT_TRUE(map.isRehashing());
+    for (int k = 0; k < n; k++) EXPECT_EQ(*refs[k], k);
+}
+
+// BATCH LOOKUP
+TEST(SeparateChainingHashMapTest, BatchLookupDuringIncrementalRehash) {
+    SeparateChainingHashMap<int, int> map(4, RehashMode::INCREMENTAL);
+    int n = 0;
+    while (!map.isRehashing()) {
+        map.put(n, n + 7);
+        n++;
+    }
+    for (int i = 0; i < 40 || !map.isRehashing(); i++) {
+        map.put(n, n + 7);
+        n++;
+    }
+    ASSERT_TRUE(map.isRehashing());
+
+    std::vector<int> keys;
+    for (int k = -5; k < 2 * n; k++) keys.push_back(k);
+    std::unique_ptr<bool[]> present(new bool[keys.size()]), found(new bool[keys.size()]);
+    std::vector<int> values(keys.size(), 0);
+
+    map.contains_batch(keys.data(), keys.size(), present.get());
+    map.get_batch(keys.data(), keys.size(), values.data(), found.get());
+
+    for (size_t i = 0; i < keys.size(); i++) {
+        bool expected = keys[i] >= 0 && keys[i] < n;
+        ASSERT_EQ(present[i], expected) << keys[i];
+        ASSERT_EQ(found[i], expected) << keys[i];
+        if (expected) {
+            EXPECT_EQ(values[i], keys[i] + 7);
+        }
+    }
+}
+
+TEST(SeparateChainingHashMapTest, BatchLookupWalksOverflowChain) {
+    SeparateChainingHashMap<int, int, ZeroHash> map;
+    for (int i = 0; i < 40; i++) map.put(i, i * i);
+
+    int keys[] = {0, 39, 40, 17, -1, 8};
+    bool found[6];
+    int values[6] = {};
+    map.get_batch(keys, 6, values, found);
+
+    EXPECT_TRUE(found[0]);
+    EXPECT_TRUE(found[1]);
+    EXPECT_FALSE(found[2]);
+    EXPECT_TRUE(found[3]);
+    EXPECT_FALSE(found[4]);
+    EXPECT_TRUE(found[5]);
+    EXPECT_EQ(values[1], 39 * 39);
+    EXPECT_EQ(values[3], 17 * 17);
+    EXPECT_EQ(values[5], 64);
+}
+
 // ITEMS
 TEST(SeparateChainingHashMapTest, ItemsReturnsAllElements) {
     SeparateChainingHashMap<int, int> map;
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "ShardedHashTable.hpp"
+#include "SeparateChainingHashTable.hpp"
+#include "LinearProbingHashTable.hpp"
+#include "map_reference_check.hpp"
+#include "../../json.hpp"
+
+// FIXTURE: одни и те же проверки для разных внутренних таблиц
+template<typename Inner>
+class ShardedHashMapTest : public ::testing::Test {
+protected:
+    using Map = ShardedHashMap<int, int, Inner>;
+};
+
+using InnerTypes = ::testing::Types<SeparateChainingHashMap<int, int>, LinearProbingHashMap<int, int>>;
+TYPED_TEST_SUITE(ShardedHashMapTest, InnerTypes);
+
+// PUT / GET / REMOVE
+TYPED_TEST(ShardedHashMapTest, PutGetRemove) {
+    typename TestFixture::Map map;
+    EXPECT_TRUE(map.empty());
+
+    map.put(1, 10);
+    map.put(2, 20);
+    map.put(1, 15);
+
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ(map.get(1), 15);
+    EXPECT_TRUE(map.contains(2));
+    EXPECT_THROW(map.get(3), std::runtime_error);
+
+    EXPECT_TRUE(map.remove(1));
+    EXPECT_FALSE(map.remove(1));
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TYPED_TEST(ShardedHashMapTest, MatchesReference) {
+    typename TestFixture::Map map(0, 8);
+    expectMatchesReference(map, 17, 20000, 3000, 3);
+}
+
+// РАСПРЕДЕЛЕНИЕ ПО ШАРДАМ
+TYPED_TEST(ShardedHashMapTest, SequentialKeysSpreadOverShards) {
+    typename TestFixture::Map map(0, 30);  // округляется до 32
+    ASSERT_EQ(map.shardCount(), 32u);
+
+    for (int i = 0; i < 32000; i++) map.put(i, i);
+
+    for (size_t s = 0; s < map.shardCount(); s++) {
+        EXPECT_GT(map.shardSize(s), 700u);
+        EXPECT_LT(map.shardSize(s), 1300u);
+    }
+}
+
+// НЕСКОЛЬКО ПОТОКОВ
+TYPED_TEST(ShardedHashMapTest, ParallelWritersOnOwnKeys) {
+    typename TestFixture::Map map;
+    const int threads = 4;
+    std::vector<std::map<int, int>> expected(threads);
+    std::vector<std::thread> pool;
+
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&, t]() {
+            std::mt19937 rng(t);
+            for (int i = 0; i < 20000; i++) {
+                int key = static_cast<int>(rng() % 4000) * threads + t;
+                if (rng() % 3) {
+                    map.put(key, i);
+                    expected[t][key] = i;
+                } else {
+                    map.remove(key);
+                    expected[t].erase(key);
+                }
+            }
+        });
+    }
+    for (auto& th : pool) th.join();
+
+    size_t total = 0;
+    for (const auto& part : expected) {
+        total += part.size();
+        for (const auto& [key, value] : part) ASSERT_EQ(map.get(key), value);
+    }
+    EXPECT_EQ(map.size(), total);
+}
+
+// CLEAR / ITEMS
+TYPED_TEST(ShardedHashMapTest, ClearAndItemsCoverAllShards) {
+    typename TestFixture::Map map(1000);
+    for (int i = 0; i < 1000; i++) map.put(i, -i);
+
+    auto all = map.items();
+    ASSERT_EQ(all.size(), 1000u);
+    std::map<int, int> collected(all.begin(), all.end());
+    EXPECT_EQ(collected.size(), 1000u);
+    EXPECT_EQ(collected[999], -999);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(map.items().empty());
+    map.put(5, 50);
+    EXPECT_EQ(map.get(5), 50);
+}
+
+// SERIALIZATION
+TYPED_TEST(ShardedHashMapTest, JsonAndBinaryRoundTrip) {
+    typename TestFixture::Map map;
+    for (int i = 0; i < 500; i++) map.put(i * 7, i);
+
+    nlohmann::json j;
+    map.to_json(j);
+    EXPECT_EQ(j["items"].size(), 500u);
+    typename TestFixture::Map fromJson(0, 4);  // другое число шардов
+    fromJson.from_json(j);
+
+    std::stringstream ss;
+    map.to_binary(ss);
+    typename TestFixture::Map fromBinary;
+    fromBinary.put(-1, -1);  // прежнее содержимое заменяется
+    fromBinary.from_binary(ss);
+
+    EXPECT_EQ(fromJson.size(), 500u);
+    EXPECT_EQ(fromBinary.size(), 500u);
+    EXPECT_FALSE(fromBinary.contains(-1));
+    for (int i = 0; i < 500; i++) {
+        EXPECT_EQ(fromJson.get(i * 7), i);
+        EXPECT_EQ(fromBinary.get(i * 7), i);
+    }
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <sstream>
+
+#include "SwissHashTable.hpp"
+#include "map_reference_check.hpp"
+#include "../../json.hpp"
+
+// БАЗОВОЕ СОСТОЯНИЕ
+TEST(SwissHashMapTest, EmptyOnCreation) {
+    SwissHashMap<int, int> map;
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_EQ(map.size(), 0u);
+}
+
+// PUT / CONTAINS / GET
+TEST(SwissHashMapTest, PutAndGet) {
+    SwissHashMap<int, int> map;
+
+    map.put(1, 100);
+    map.put(2, 200);
+
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_TRUE(map.contains(1));
+    EXPECT_TRUE(map.contains(2));
+    EXPECT_EQ(map.get(1), 100);
+    EXPECT_EQ(map.get(2), 200);
+}
+
+TEST(SwissHashMapTest, PutUpdatesValue) {
+    SwissHashMap<int, int> map;
+
+    map.put(1, 100);
+    map.put(1, 500);
+
+    EXPECT_EQ(map.size(), 1u);
+    EXPECT_EQ(map.get(1), 500);
+}
+
+// REMOVE
+TEST(SwissHashMapTest, RemoveExistingKey) {
+    SwissHashMap<int, int> map;
+
+    map.put(1, 100);
+    map.put(2, 200);
+
+    EXPECT_TRUE(map.remove(1));
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(SwissHashMapTest, RemoveNonExistingKey) {
+    SwissHashMap<int, int> map;
+
+    map.put(1, 100);
+    EXPECT_FALSE(map.remove(999));
+    EXPECT_EQ(map.size(), 1u);
+}
+
+// GET EXCEPTIONS
+TEST(SwissHashMapTest, GetThrowsWhenNotFound) {
+    SwissHashMap<int, int> map;
+
+    map.put(1, 100);
+    EXPECT_THROW(map.get(2), std::runtime_error);
+}
+
+// GROUPS
+TEST(SwissHashMapTest, CapacityIsWholeGroups) {
+    SwissHashMap<int, int> map(20);
+    EXPECT_EQ(map.getCapacity(), 32u);
+}
+
+TEST(SwissHashMapTest, FullGroupsKeepKeysReachableAfterRemove) {
+    SwissHashMap<int, int> map(128);
+
+    // 100 ключей в 8 группах: часть групп заполнена целиком, удаление
+    // в них оставляет DELETED, и поиск продолжается в следующих группах
+    for (int i = 0; i < 100; i++) map.put(i, i);
+    EXPECT_EQ(map.getCapacity(), 128u);
+
+    for (int i = 0; i < 100; i += 2) EXPECT_TRUE(map.remove(i));
+    for (int i = 1; i < 100; i += 2) EXPECT_EQ(map.get(i), i);
+    for (int i = 0; i < 100; i += 2) EXPECT_FALSE(map.contains(i));
+
+    for (int i = 1000; i < 1050; i++) map.put(i, i);
+    EXPECT_EQ(map.size(), 100u);
+    for (int i = 1000; i < 1050; i++) EXPECT_EQ(map.get(i), i);
+}
+
+TEST(SwissHashMapTest, ChurnDoesNotGrowTable) {
+    SwissHashMap<int, int> map(64);
+
+    for (int i = 0; i < 10000; i++) {
+        map.put(i, i);
+        if (i >= 10) {
+            EXPECT_TRUE(map.remove(i - 10));
+        }
+    }
+
+    EXPECT_EQ(map.size(), 10u);
+    EXPECT_EQ(map.getCapacity(), 64u);
+    for (int i = 9990; i < 10000; i++) EXPECT_EQ(map.get(i), i);
+}
+
+// GROWTH
+TEST(SwissHashMapTest, GrowsWhenLoadFactorExceeded) {
+    SwissHashMap<int, int> map(3);
+
+    for (int i = 0; i < 1000; i++) {
+        map.put(i, i * 10);
+    }
+
+    EXPECT_EQ(map.size(), 1000u);
+    EXPECT_GE(map.getCapacity(), 1000u);
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(map.get(i), i * 10);
+    }
+}
+
+TEST(SwissHashMapTest, MatchesReference) {
+    SwissHashMap<int, int> map(8);
+    expectMatchesReference(map, 11, 20000, 500, 3);
+}
+
+// CLEAR
+TEST(SwissHashMapTest, ClearEmptiesMap) {
+    SwissHashMap<int, int> map;
+
+    map.put(1, 10);
+    map.put(2, 20);
+
+    map.clear();
+
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_FALSE(map.contains(1));
+
+    map.put(1, 30);
+    EXPECT_EQ(map.get(1), 30);
+}
+
+// DISPLAY (cout)
+TEST(SwissHashMapTest, DisplayOutputsData) {
+    SwissHashMap<int, int> map;
+    map.put(1, 100);
+    map.put(2, 200);
+
+    std::stringstream buffer;
+    auto* old = std::cout.rdbuf(buffer.rdbuf());
+
+    map.display();
+
+    std::cout.rdbuf(old);
+
+    std::string output = buffer.str();
+    EXPECT_NE(output.find("1 : 100"), std::string::npos);
+    EXPECT_NE(output.find("2 : 200"), std::string::npos);
+}
+
+// JSON SERIALIZATION
+TEST(SwissHashMapTest, JsonSerializeDeserialize) {
+    SwissHashMap<int, int> map;
+
+    map.put(1, 100);
+    map.put(2, 200);
+    map.put(3, 300);
+
+    nlohmann::json j;
+    map.to_json(j);
+
+    SwissHashMap<int, int> restored;
+    restored.from_json(j);
+
+    EXPECT_EQ(restored.size(), 3u);
+    EXPECT_EQ(restored.get(1), 100);
+    EXPECT_EQ(restored.get(2), 200);
+    EXPECT_EQ(restored.get(3), 300);
+}
+
+// BINARY SERIALIZATION
+TEST(SwissHashMapTest, BinarySerializeDeserialize) {
+    SwissHashMap<int, int> map;
+    for (int i = 0; i < 50; i++) map.put(i, i + 1);
+
+    std::stringstream ss;
+    map.to_binary(ss);
+
+    SwissHashMap<int, int> restored;
+    restored.from_binary(ss);
+
+    EXPECT_EQ(restored.size(), 50u);
+    for (int i = 0; i < 50; i++) {
+        EXPECT_EQ(restored.get(i), i + 1);
+    }
+}
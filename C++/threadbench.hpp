@@ -0,0 +1,215 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <type_traits>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <exception>
+
+#include "benchmark.hpp"
+#include "workload.hpp"
+
+using namespace std;
+
+// Точка кривой масштабирования: threads потоков в режиме mode
+struct ThreadPoint {
+    int threads = 1;
+    string mode;            // independent — своя структура у потока, shared — одна под мьютексом,
+                            // concurrent — одна без мьютекса (структура синхронизируется сама)
+    long long ops = 0;      // операций за один замер во всех потоках
+    BenchStats stats;       // время от общего старта до завершения последнего потока
+    double throughput = 0;  // операций в секунду по медиане
+    double efficiency = 0;  // throughput / (threads * throughput при одном потоке)
+};
+
+// Общий старт потоков: подготовка структур и создание потоков не попадают в замер
+class StartGate {
+private:
+    atomic<int> ready{0};
+    atomic<bool> go{false};
+    vector<char> arrived;
+    vector<chrono::steady_clock::time_point> finish;
+
+public:
+    explicit StartGate(int threads) : arrived(threads, 0), finish(threads) {}
+
+    void arrive(int t) {
+        if (arrived[t]) return;
+        arrived[t] = 1;
+        ready.fetch_add(1);
+    }
+
+    void arriveAndWait(int t) {
+        arrive(t);
+        while (!go.load(memory_order_acquire)) this_thread::yield();
+    }
+
+    void done(int t) { finish[t] = chrono::steady_clock::now(); }
+
+    // Ждёт готовности всех потоков и даёт старт; возвращает момент старта
+    chrono::steady_clock::time_point release(int threads) {
+        while (ready.load() < threads) this_thread::yield();
+        auto start = chrono::steady_clock::now();
+        go.store(true, memory_order_release);
+        return start;
+    }
+
+    chrono::steady_clock::time_point lastFinish() const {
+        return *max_element(finish.begin(), finish.end());
+    }
+};
+
+// body(t, gate) готовит данные, вызывает gate.arriveAndWait(t), выполняет
+// работу и отмечает gate.done(t). Возвращает время до завершения последнего потока
+template<typename Body>
+long long runConcurrently(int threads, Body body) {
+    StartGate gate(threads);
+    vector<exception_ptr> errors(threads);
+    vector<thread> pool;
+
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t]() {
+            try {
+                body(t, gate);
+            } catch (...) {
+                errors[t] = current_exception();
+                gate.arrive(t);
+                gate.done(t);
+            }
+        });
+    }
+
+    auto start = gate.release(threads);
+    for (auto& th : pool) th.join();
+
+    for (auto& e : errors) {
+        if (e) rethrow_exception(e);
+    }
+    return chrono::duration_cast<chrono::nanoseconds>(gate.lastFinish() - start).count();
+}
+
+// Ключи и поток операций одного потока. insert/find/remove сводятся
+// к однотипному потоку, mixed — к смешанному, как в runMixedBenchmark
+struct ThreadWorkload {
+    vector<int> preload;
+    vector<MixedOp> ops;
+};
+
+inline ThreadWorkload makeThreadWorkload(const string& operation, const WorkloadConfig& workload,
+                                         int n, int threadIndex, const MixedRatio& ratio) {
+    WorkloadConfig cfg = workload;
+    cfg.seed = workload.seed + 7919u * threadIndex;
+    vector<int> keys = generateData(cfg, n);
+
+    ThreadWorkload w;
+    if (operation == "mixed") {
+        w.preload = keys;
+        w.ops = generateMixedOps(cfg, keys, n, ratio);
+        return w;
+    }
+
+    MixedOp::Type type;
+    if (operation == "insert") type = MixedOp::INSERT;
+    else if (operation == "find") type = MixedOp::READ;
+    else if (operation == "remove") type = MixedOp::REMOVE;
+    else throw runtime_error("Неизвестная операция: " + operation);
+
+    if (type != MixedOp::INSERT) w.preload = keys;
+    for (int k : keys) w.ops.push_back({type, k});
+    return w;
+}
+
+// Структуры со своей синхронизацией (static constexpr bool concurrent = true)
+// в общем режиме замеряются без внешнего мьютекса
+template<typename DS, typename = void>
+struct isConcurrent : false_type {};
+
+template<typename DS>
+struct isConcurrent<DS, enable_if_t<DS::concurrent>> : true_type {};
+
+// make(capacity, f) создаёт новую структуру и вызывает f(ds); capacity — ёмкость
+// для таблиц, которые не растут сами. Для 1, 2, 4, ..., maxThreads потоков
+// замеряет независимые экземпляры и, если shared, один общий под мьютексом
+template<typename Make>
+vector<ThreadPoint> runThreadScaling(Make make, const string& operation, const WorkloadConfig& workload,
+                                     int n, int maxThreads, bool shared, const MixedRatio& ratio,
+                                     const BenchConfig& cfg) {
+    vector<int> counts;
+    for (int t = 1; t < maxThreads; t *= 2) counts.push_back(t);
+    counts.push_back(maxThreads);
+
+    vector<ThreadWorkload> work;
+    for (int t = 0; t < maxThreads; ++t) {
+        work.push_back(makeThreadWorkload(operation, workload, n, t, ratio));
+    }
+
+    vector<ThreadPoint> points;
+    auto addPoint = [&](int threads, const string& mode, const vector<long long>& samples) {
+        ThreadPoint p;
+        p.threads = threads;
+        p.mode = mode;
+        for (int t = 0; t < threads; ++t) p.ops += work[t].ops.size();
+        p.stats = computeStats(samples);
+        p.throughput = p.stats.median > 0 ? p.ops * 1e9 / p.stats.median : 0;
+        for (const auto& q : points) {
+            if (q.mode == mode && q.threads == 1 && q.throughput > 0) {
+                p.efficiency = p.throughput / (threads * q.throughput);
+            }
+        }
+        if (threads == 1) p.efficiency = 1;
+        points.push_back(p);
+    };
+
+    for (int threads : counts) {
+        vector<long long> samples;
+        for (int r = 0; r < cfg.warmup + cfg.repeats; ++r) {
+            long long ns = runConcurrently(threads, [&](int t, StartGate& gate) {
+                make(2 * static_cast<size_t>(n), [&](auto& ds) {
+                    for (int x : work[t].preload) benchInsert(ds, x);
+                    gate.arriveAndWait(t);
+                    for (const auto& op : work[t].ops) runMixedOp(ds, op);
+                    gate.done(t);
+                });
+            });
+            if (r >= cfg.warmup) samples.push_back(ns);
+        }
+        addPoint(threads, "independent", samples);
+    }
+
+    if (!shared) return points;
+
+    for (int threads : counts) {
+        vector<long long> samples;
+        bool ownSync = false;
+        make(2 * static_cast<size_t>(n) * threads, [&](auto& ds) {
+            constexpr bool concurrent = isConcurrent<decay_t<decltype(ds)>>::value;
+            ownSync = concurrent;
+            mutex lock;
+            for (int r = 0; r < cfg.warmup + cfg.repeats; ++r) {
+                ds.clear();
+                for (int t = 0; t < threads; ++t) {
+                    for (int x : work[t].preload) benchInsert(ds, x);
+                }
+                long long ns = runConcurrently(threads, [&](int t, StartGate& gate) {
+                    gate.arriveAndWait(t);
+                    for (const auto& op : work[t].ops) {
+                        if constexpr (concurrent) {
+                            runMixedOp(ds, op);
+                        } else {
+                            lock_guard<mutex> guard(lock);
+                            runMixedOp(ds, op);
+                        }
+                    }
+                    gate.done(t);
+                });
+                if (r >= cfg.warmup) samples.push_back(ns);
+            }
+        });
+        addPoint(threads, ownSync ? "concurrent" : "shared", samples);
+    }
+
+    return points;
+}
@@ -0,0 +1,169 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <random>
+#include <cmath>
+#include <climits>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+// Параметры генерации ключей для бенчмарка
+struct WorkloadConfig {
+    string distribution = "uniform";
+    unsigned seed = 42;
+    int stride = 16;         // strided: шаг между ключами
+    long long modulus = 0;   // adversarial: ключи кратны modulus (0 — взять n)
+    double theta = 0.99;     // zipf: показатель распределения
+    int clusterSize = 64;    // clustered: длина диапазона подряд идущих ключей
+};
+
+// Распределение Ципфа по рангам 0..n-1: ранг 0 — самый горячий ключ
+class ZipfGenerator {
+private:
+    vector<double> cdf;
+
+public:
+    ZipfGenerator(size_t n, double theta) : cdf(n) {
+        double sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += 1.0 / pow(static_cast<double>(i + 1), theta);
+            cdf[i] = sum;
+        }
+        for (auto& x : cdf) x /= sum;
+    }
+
+    template<typename Rng>
+    size_t operator()(Rng& rng) {
+        double u = uniform_real_distribution<double>(0.0, 1.0)(rng);
+        size_t rank = lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin();
+        return min(rank, cdf.size() - 1);
+    }
+};
+
+inline vector<int> generateData(const WorkloadConfig& cfg, int n) {
+    vector<int> data(n);
+    mt19937 rng(cfg.seed);
+    const string& d = cfg.distribution;
+
+    if (d == "uniform") {
+        uniform_int_distribution<int> dist(0, n * 10);
+        for (auto& x : data) x = dist(rng);
+    }
+    else if (d == "sequential") {
+        for (int i = 0; i < n; ++i) data[i] = i;
+    }
+    else if (d == "strided") {
+        if (cfg.stride <= 0) throw invalid_argument("Шаг должен быть положительным");
+        for (int i = 0; i < n; ++i) {
+            data[i] = static_cast<int>((static_cast<long long>(i) * cfg.stride) % INT_MAX);
+        }
+    }
+    else if (d == "zipf") {
+        // Поток из n обращений: ранг выбирается по закону Ципфа, ключ ранга —
+        // случайный из [0, 10n]. Горячие ключи повторяются, поэтому разных
+        // ключей заметно меньше n (при theta = 0.99 около четверти), и insert
+        // по таким данным в основном обновляет уже вставленные
+        vector<int> keys(n);
+        uniform_int_distribution<int> dist(0, n * 10);
+        for (auto& k : keys) k = dist(rng);
+
+        ZipfGenerator zipf(n, cfg.theta);
+        for (auto& x : data) x = keys[zipf(rng)];
+    }
+    else if (d == "clustered") {
+        if (cfg.clusterSize <= 0) throw invalid_argument("Размер кластера должен быть положительным");
+        uniform_int_distribution<int> dist(0, n * 10);
+        int base = 0;
+        for (int i = 0; i < n; ++i) {
+            if (i % cfg.clusterSize == 0) base = dist(rng);
+            data[i] = base + i % cfg.clusterSize;
+        }
+        shuffle(data.begin(), data.end(), rng);
+    }
+    else if (d == "adversarial") {
+        // Кратные ёмкости таблицы: при хэше key % capacity все попадают в одну ячейку.
+        // Когда кратные не помещаются в int, сдвигаемся на 1, 2, ...
+        long long m = cfg.modulus > 0 ? cfg.modulus : n;
+        if (m <= 0 || m > INT_MAX) throw invalid_argument("Некорректный модуль");
+        long long q = INT_MAX / m;
+        for (int i = 0; i < n; ++i) {
+            data[i] = static_cast<int>((i % q) * m + i / q);
+        }
+    }
+    else {
+        throw invalid_argument("Неизвестное распределение: " + d);
+    }
+
+    return data;
+}
+
+// Доли операций смешанной нагрузки (в процентах или любых весах)
+struct MixedRatio {
+    int read = 50;
+    int insert = 45;
+    int remove = 5;
+};
+
+struct MixedOp {
+    enum Type { READ, INSERT, REMOVE };
+    Type type;
+    int key;
+};
+
+// Разбирает строку вида "50:45:5" (чтение:вставка:удаление)
+inline MixedRatio parseMixedRatio(const string& s) {
+    MixedRatio r;
+    size_t a = s.find(':');
+    size_t b = a == string::npos ? string::npos : s.find(':', a + 1);
+    if (b == string::npos) throw invalid_argument("Ожидается формат чтение:вставка:удаление, например 50:45:5");
+    r.read = stoi(s.substr(0, a));
+    r.insert = stoi(s.substr(a + 1, b - a - 1));
+    r.remove = stoi(s.substr(b + 1));
+    if (r.read < 0 || r.insert < 0 || r.remove < 0 || r.read + r.insert + r.remove == 0) {
+        throw invalid_argument("Некорректные доли операций: " + s);
+    }
+    return r;
+}
+
+// Поток операций в духе YCSB: чтения и удаления берут ключи из уже
+// загруженных (с той же популярностью, что в preload), вставки — новые
+// ключи из того же распределения. Удалённый ключ больше не выбирается.
+// Если загруженных ключей не осталось, чтение и удаление получают новый
+// ключ, которого нет в структуре (промах)
+inline vector<MixedOp> generateMixedOps(const WorkloadConfig& cfg, const vector<int>& preload,
+                                        int ops, const MixedRatio& ratio) {
+    WorkloadConfig insertCfg = cfg;
+    insertCfg.seed = cfg.seed + 1;
+    vector<int> fresh = generateData(insertCfg, ops);
+
+    mt19937 rng(cfg.seed + 2);
+    discrete_distribution<int> pick({
+        static_cast<double>(ratio.read),
+        static_cast<double>(ratio.insert),
+        static_cast<double>(ratio.remove)
+    });
+
+    vector<int> pool = preload;
+    vector<MixedOp> result(ops);
+    for (int i = 0; i < ops; ++i) {
+        MixedOp::Type type = static_cast<MixedOp::Type>(pick(rng));
+        int key;
+        if (type == MixedOp::INSERT) {
+            key = fresh[i];
+            pool.push_back(key);
+        } else if (pool.empty()) {
+            key = fresh[i];
+        } else {
+            size_t idx = uniform_int_distribution<size_t>(0, pool.size() - 1)(rng);
+            key = pool[idx];
+            if (type == MixedOp::REMOVE) {
+                pool[idx] = pool.back();
+                pool.pop_back();
+            }
+        }
+        result[i] = {type, key};
+    }
+    return result;
+}